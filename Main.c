@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <string.h>
 #include "pico/stdlib.h"
 #include "hardware/pwm.h"
 #include "hardware/adc.h"
@@ -12,7 +13,14 @@
 #include "lib/buzzer.h"
 #include "lib/leds.h"
 #include "lib/matrizRGB.h"
+#include "lib/ciclos.h"
+#include "lib/cor.h"
+#include "lib/animacao.h"
+#include "lib/adc_dma.h"
+#include "lib/filtro_entrada.h"
 #include "lib/ssd1306.h"
+#include "lib/ssd1306_scene.h"
+#include "lib/ssd1306_sched.h"
 
 // ==============================
 // Definições dos pinos
@@ -46,15 +54,33 @@ volatile bool mudanca_estado = true;
 #define I2C_SDA 14
 #define I2C_SCL 15
 #define I2C_ADDR 0x3C
+#define DISPLAY_FPS 30 // Taxa máxima de atualização do display
+#define JOYSTICK_TAXA_HZ 2000 // Amostras por segundo de cada eixo (ADC + DMA)
+#define MATRIZ_LIMITE_MA 500 // Orçamento de corrente da matriz (a placa é alimentada pela USB)
 
 volatile uint32_t last_button_time = 0;
 static ssd1306_t ssd;
-volatile uint16_t adc_x_anterior = 0;
-volatile uint16_t adc_y_anterior = 0;
+static scene_t cena;
+static ssd1306_sched_t agenda_display;
+static int quadrado_id = -1;
 volatile uint16_t adc_x_valor = 0;
 volatile uint16_t adc_y_valor = 0;
+
+// Filtro do joystick: média de 8 amostras (250 Hz por eixo), IIR com alfa 1/2,
+// zona morta de 24 contagens no centro e folga de 4 contagens contra o ruído
+static const filtro_config_t filtro_joystick = {
+    .decimacao = 3,
+    .tipo = FILTRO_IIR,
+    .iir_shift = 1,
+    .zona_morta = 24,
+    .histerese = 4,
+};
+filtro_t filtro_x, filtro_y;
+uint32_t posicao_x, posicao_y; // Amostras do ADC já passadas aos filtros
 volatile bool led_rgb_estado = false;
 volatile bool matriz_estado = false;
+volatile bool dithering_estado = false;
+uint8_t efeito_led_rgb = 0; // 0 = fixo, 1 = respiração, 2 = ciclo de cores
 
 // ==============================
 // Funções auxiliares
@@ -87,6 +113,18 @@ void init_joystick_adc()
     adc_init();
     adc_gpio_init(VRX_PIN);
     adc_gpio_init(VRY_PIN);
+    adc_dma_iniciar(JOYSTICK_TAXA_HZ); // Amostragem contínua, independente do laço
+
+    // Centro medido com o joystick solto, a partir de um bloco do anel
+    uint16_t bloco[ADC_DMA_BLOCO_MAX];
+    filtro_iniciar(&filtro_x, &filtro_joystick);
+    filtro_iniciar(&filtro_y, &filtro_joystick);
+    sleep_ms(1000 * ADC_DMA_BLOCO_MAX / JOYSTICK_TAXA_HZ + 1);
+    bool centro_x = filtro_calibrar_centro(&filtro_x, bloco, adc_dma_bloco(ADC_DMA_CANAL_X, bloco, ADC_DMA_BLOCO_MAX));
+    bool centro_y = filtro_calibrar_centro(&filtro_y, bloco, adc_dma_bloco(ADC_DMA_CANAL_Y, bloco, ADC_DMA_BLOCO_MAX));
+    if (!centro_x || !centro_y)
+        printf("Joystick fora do repouso na calibracao: usando o centro nominal\n");
+    posicao_x = posicao_y = adc_dma_amostras();
 }
 
 void init_buttons()
@@ -107,6 +145,7 @@ void remapear_valores(uint16_t valor_x, uint16_t valor_y, Remapeamento *resultad
 void limpar_serial_monitor();
 void gpio_irq_handle(uint gpio, uint32_t events);
 void mostrarMenu();
+void medir_kernels_cor(uint32_t ciclos[3]);
 
 int main(void)
 {
@@ -114,14 +153,17 @@ int main(void)
 
     init_i2c();
     init_display();
+    ssd1306_sched_init(&agenda_display, &ssd, DISPLAY_FPS, true);
     init_joystick_adc();
     init_buttons();
 
     npInit(7);
+    npSetLimiteCorrente(MATRIZ_LIMITE_MA);
     led_init();
     buzzer_init();
 
     Remapeamento dados;
+    uint32_t ciclos_cor[3] = {0}; // Misturar, escalar e HSV, medidos ao entrar no modo de debug
     uint32_t tempo_anterior = 0;
 
     gpio_set_irq_enabled_with_callback(BUTTON_A, GPIO_IRQ_EDGE_FALL, true, &gpio_irq_handle);
@@ -134,10 +176,15 @@ int main(void)
         // Realiza leitura do joystick
         // ==============================
 
-        adc_select_input(0);
-        uint16_t adc_y = adc_read();
-        adc_select_input(1);
-        uint16_t adc_x = adc_read();
+        // Amostras novas de cada eixo desde a última volta, pelo filtro; o DMA
+        // mantém o anel atualizado
+        uint16_t bloco[ADC_DMA_BLOCO_MAX];
+        size_t n = adc_dma_novas(ADC_DMA_CANAL_Y, &posicao_y, bloco, ADC_DMA_BLOCO_MAX);
+        adc_y_valor = filtro_processar(&filtro_y, bloco, n);
+        n = adc_dma_novas(ADC_DMA_CANAL_X, &posicao_x, bloco, ADC_DMA_BLOCO_MAX);
+        adc_x_valor = filtro_processar(&filtro_x, bloco, n);
+
+        animacao_atualizar(); // Avança a animação da matriz, se houver uma tocando
 
         /*
     Debugação:
@@ -164,21 +211,15 @@ int main(void)
     - Valor máximo de y: 4073, mínimo: 11-12.
     - Valor máximo de x: 4073, mínimo: 11-12.
 
+    O ruído do ADC é tratado pelo filtro (lib/filtro_entrada.h): a zona morta e a
+    folga seguram o quadrado parado sem o antigo limiar de 50 contagens.
+
     Para remapear os valores, será criada a função remap, que receberá adc_y e adc_x e retornará os valores ajustados.
     Também será utilizada `struct` e ponteiro, conforme sugestão do professor Ricardo.
-*/
 
-        ssd1306_draw_string(&ssd, "A", 123 - 8, 63 - 8);
-
-        // Só vou realmente atualizar os valores se houver uma diferença significativa entre os valores atuais e os anteriores.
-        // Isso evita o display ficar piscando sem parar e etc.
-        if (abs(adc_y - adc_y_anterior) > 50 || abs(adc_x - adc_x_anterior) > 50)
-        {
-            adc_y_valor = adc_y;
-            adc_x_valor = adc_x;
-            adc_y_anterior = adc_y;
-            adc_x_anterior = adc_x;
-        }
+    O 'A' agora é um elemento fixo da cena do MODO_PADRAO: é desenhado uma vez e só
+    é repintado se o quadrado passar por cima dele.
+*/
 
         // ==============================
         // Máquina de estados
@@ -192,16 +233,25 @@ int main(void)
         {
             if (mudanca_estado)
             {
-                ssd1306_fill(&ssd, false);
-                ssd1306_send_data(&ssd);
+                // Monta a cena uma única vez: 'A' fixo e o quadrado do joystick por cima
+                remapear_valores(adc_x_valor, adc_y_valor, &dados);
+                scene_init(&cena, &ssd);
+                scene_add_text(&cena, 123 - 8, 63 - 8, "A", 0);
+                quadrado_id = scene_add_rect(&cena, dados.x_mapeado, dados.y_mapeado, SQUARE_SIZE, SQUARE_SIZE, true, 1);
+                ssd1306_sched_resume(&agenda_display); // O tempo em outro modo não conta como quadros perdidos
                 limpar_serial_monitor();
                 mudanca_estado = false;
             }
 
-            remapear_valores(adc_x_valor, adc_y_valor, &dados);
-            ssd1306_fill(&ssd, false);
-            draw_square(&ssd, dados.x_mapeado, dados.y_mapeado);
-            ssd1306_send_data(&ssd);
+            // Desenha no ritmo do agendador; entre quadros o laço segue livre.
+            // Só a união da posição antiga e nova do quadrado é redesenhada.
+            if (ssd1306_sched_begin_frame(&agenda_display))
+            {
+                remapear_valores(adc_x_valor, adc_y_valor, &dados);
+                scene_move(&cena, quadrado_id, dados.x_mapeado, dados.y_mapeado);
+                scene_render(&cena);
+                ssd1306_sched_end_frame(&agenda_display); // Não bloqueia: o DMA envia enquanto o laço continua
+            }
             break;
         }
 
@@ -213,6 +263,8 @@ int main(void)
                 limpar_serial_monitor();
                 ssd1306_fill(&ssd, false);
                 ssd1306_send_data(&ssd);
+                ciclos_iniciar(); // SysTick só para as medidas de ciclos deste modo
+                medir_kernels_cor(ciclos_cor);
                 mudanca_estado = false;
             }
 
@@ -221,6 +273,35 @@ int main(void)
                 tempo_anterior = tempo_atual;
                 limpar_serial_monitor();
                 printf("X: %-4d Y: %-4d\n", adc_x_valor, adc_y_valor);
+                printf("Bytes enviados ao display: %lu\n", (unsigned long)ssd.bytes_sent);
+
+                ssd1306_sched_stats_t stats;
+                ssd1306_sched_get_stats(&agenda_display, &stats);
+                printf("Display: %lu.%lu FPS | enviados %lu | pulados %lu | descartados %lu\n",
+                       (unsigned long)(stats.fps_x10 / 10), (unsigned long)(stats.fps_x10 % 10),
+                       (unsigned long)stats.frames_sent, (unsigned long)stats.frames_skipped,
+                       (unsigned long)stats.frames_dropped);
+                printf("Envio: último %lu us | médio %lu us | máximo %lu us\n",
+                       (unsigned long)stats.flush_last_us, (unsigned long)stats.flush_avg_us,
+                       (unsigned long)stats.flush_max_us);
+
+                uint32_t corrente_estimada, corrente_limitada;
+                npGetCorrente(&corrente_estimada, &corrente_limitada);
+                printf("Matriz: estimado %lu mA | limitado %lu mA (limite %u mA)\n",
+                       (unsigned long)corrente_estimada, (unsigned long)corrente_limitada, MATRIZ_LIMITE_MA);
+                printf("Estágio de cor: %lu ciclos por quadro (%lu por LED)\n",
+                       (unsigned long)npGetCiclosConversao(), (unsigned long)(npGetCiclosConversao() / LED_COUNT));
+                printf("Kernels de cor (ciclos/LED): misturar %lu | escalar %lu | hsv %lu\n",
+                       (unsigned long)(ciclos_cor[0] / LED_COUNT), (unsigned long)(ciclos_cor[1] / LED_COUNT),
+                       (unsigned long)(ciclos_cor[2] / LED_COUNT));
+
+                if (dithering_estado)
+                {
+                    uint32_t custo_dithering, fps_dithering;
+                    npGetDithering(&custo_dithering, &fps_dithering);
+                    printf("Dithering: %lu us por quadro | %lu FPS\n",
+                           (unsigned long)custo_dithering, (unsigned long)fps_dithering);
+                }
             }
             break;
         }
@@ -243,18 +324,21 @@ int main(void)
                     {
                     case '1':
                         led_rgb_estado = !led_rgb_estado;
-                        led_rgb_estado ? acender_led_rgb(255, 255, 255) : turn_off_leds();
+                        efeito_led_rgb = 0;
+                        led_rampa(led_rgb_estado ? COLOR_WHITE : COLOR_BLACK, 300); // Fade na interrupção do PWM
                         mostrarMenu();
                         break;
 
                     case '2':
+                        animacao_parar(); // A matriz volta a ser controlada pelo menu
                         matriz_estado = !matriz_estado;
                         matriz_estado ? acenderTodaMatrizIntensidade(COLOR_WHITE, 1.0) : npClear();
                         mostrarMenu();
                         break;
 
                     case '3':
-                        play_mario_kart_theme(1);
+                        // Não bloqueia; apertar de novo durante a música interrompe
+                        buzzer_tocando() ? buzzer_parar() : play_mario_kart_duas_vozes();
                         mostrarMenu();
                         break;
 
@@ -278,7 +362,7 @@ int main(void)
 
                     case '6':
                         matriz_estado = true;
-                        animar_desenhos(350, 10, caixa_de_desenhos, (1), (1), (1));
+                        animacao_tocar(&desenhos_numeros, false, 0); // Não bloqueia: o laço continua atendendo
                         mostrarMenu();
                         break;
 
@@ -287,6 +371,26 @@ int main(void)
                         mudanca_estado = true;
                         break;
 
+                    case '8':
+                        dithering_estado = !dithering_estado;
+                        npSetDithering(dithering_estado);
+                        mostrarMenu();
+                        break;
+
+                    case '9':
+                        if (led_rgb_estado)
+                        {
+                            efeito_led_rgb = (efeito_led_rgb + 1) % 3;
+                            if (efeito_led_rgb == 1)
+                                led_respirar(COLOR_CYAN, 3000);
+                            else if (efeito_led_rgb == 2)
+                                led_ciclo_hsv(255, 255, 6000);
+                            else
+                                led_rampa(COLOR_WHITE, 300);
+                            mostrarMenu();
+                        }
+                        break;
+
                     default:
                         // Ignora outros caracteres
                         break;
@@ -307,11 +411,13 @@ void mostrarMenu()
     printf("Terminal Ativo - Escolha uma opção:\n");
     printf("1 - Ligar/Desligar LED RGB\n");
     printf("2 - Ligar/Desligar matriz RGB 5x5\n");
-    printf("3 - Tocar tema do Mário\n");
+    printf("3 - Tocar/Parar tema do Mário\n");
     printf("4 - Trocar cor do Led RGB para uma cor aleatória\n");
     printf("5 - Alterar força do Led de forma aleatória\n");
     printf("6 - Mostrar números de 0 a 9 na matriz RGB 5x5\n");
     printf("7 - Sair do terminal\n");
+    printf("8 - Ligar/Desligar dithering temporal da matriz\n");
+    printf("9 - Trocar efeito do LED RGB (fixo, respiração, ciclo de cores)\n");
 }
 
 void remapear_valores(uint16_t valor_x, uint16_t valor_y, Remapeamento *resultado)
@@ -325,6 +431,37 @@ void limpar_serial_monitor()
     printf("\033[2J\033[H");
 }
 
+// Ciclos de cor_misturar_leds, cor_escalar_leds e cor_hsv_para_leds sobre um
+// quadro do tamanho da matriz (uma cópia de 'leds', para não mexer no que está
+// aceso). Fica o menor de algumas rodadas, que descarta as interrupções.
+void medir_kernels_cor(uint32_t ciclos[3])
+{
+    static npLED_t copia[LED_COUNT];
+    static cor_hsv_t hsv[LED_COUNT];
+    for (uint i = 0; i < LED_COUNT; ++i)
+        hsv[i] = (cor_hsv_t){(i * 61) % COR_MATIZ_VOLTA, 255 - i * 5, 128 + i * 5};
+
+    ciclos[0] = ciclos[1] = ciclos[2] = UINT32_MAX;
+    for (uint rodada = 0; rodada < 8; ++rodada)
+    {
+        memcpy(copia, leds, sizeof(copia));
+        uint32_t inicio = ciclos_agora();
+        cor_misturar_leds(copia, LED_COUNT, (npColor_t){40, 200, 90}, 100);
+        uint32_t gasto = ciclos_desde(inicio);
+        ciclos[0] = gasto < ciclos[0] ? gasto : ciclos[0];
+
+        inicio = ciclos_agora();
+        cor_escalar_leds(copia, LED_COUNT, 180);
+        gasto = ciclos_desde(inicio);
+        ciclos[1] = gasto < ciclos[1] ? gasto : ciclos[1];
+
+        inicio = ciclos_agora();
+        cor_hsv_para_leds(copia, hsv, LED_COUNT);
+        gasto = ciclos_desde(inicio);
+        ciclos[2] = gasto < ciclos[2] ? gasto : ciclos[2];
+    }
+}
+
 void gpio_irq_handle(uint gpio, uint32_t events)
 {
     uint32_t current_time = to_ms_since_boot(get_absolute_time());
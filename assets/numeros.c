@@ -0,0 +1,40 @@
+#include <stdint.h>
+
+#define NUMEROS_FRAME_COUNT 10
+#define NUMEROS_FRAME_WIDTH 5
+#define NUMEROS_FRAME_HEIGHT 5
+
+/* Piskel data for "numeros" */
+
+static const uint32_t numeros_data[10][25] = {
+{
+0xff0000fe, 0xff0000fe, 0xff0000fe, 0xff0000fe, 0xff0000fe, 0xff0000fe, 0x00000000, 0x00000000, 0xff0000fe, 0xff0000fe, 0xff0000fe, 0x00000000, 0xff0000fe, 0x00000000, 0xff0000fe, 0xff0000fe, 0xff0000fe, 0x00000000, 0x00000000, 0xff0000fe, 0xff0000fe, 0xff0000fe, 0xff0000fe, 0xff0000fe, 0xff0000fe
+},
+{
+0x00000000, 0x00000000, 0xff00ff00, 0x00000000, 0x00000000, 0x00000000, 0xff00ff00, 0xff00ff00, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff00ff00, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff00ff00, 0x00000000, 0x00000000, 0x00000000, 0xff00ff00, 0xff00ff00, 0xff00ff00, 0x00000000
+},
+{
+0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xffff0000, 0x00000000, 0xffff0000, 0xffff0000, 0xffff0000, 0x00000000, 0xffff0000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000, 0xffff0000
+},
+{
+0xffff0085, 0xffff0085, 0xffff0085, 0xffff0085, 0xffff0085, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xffff0085, 0x00000000, 0xffff0085, 0xffff0085, 0xffff0085, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xffff0085, 0xffff0085, 0xffff0085, 0xffff0085, 0xffff0085, 0xffff0085
+},
+{
+0xff87ff7a, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff87ff7a, 0x00000000, 0x00000000, 0xff87ff7a, 0x00000000, 0xff87ff7a, 0x00000000, 0x00000000, 0xff87ff7a, 0x00000000, 0xff87ff7a, 0xff87ff7a, 0xff87ff7a, 0xff87ff7a, 0xff87ff7a, 0x00000000, 0x00000000, 0x00000000, 0xff87ff7a, 0x00000000
+},
+{
+0xff00dbff, 0xff00dbff, 0xff00dbff, 0xff00dbff, 0xff00dbff, 0xff00dbff, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff00dbff, 0xff00dbff, 0xff00dbff, 0xff00dbff, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xff00dbff, 0xff00dbff, 0xff00dbff, 0xff00dbff, 0xff00dbff, 0x00000000
+},
+{
+0xfffd02ff, 0xfffd02ff, 0xfffd02ff, 0xfffd02ff, 0xfffd02ff, 0xfffd02ff, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xfffd02ff, 0xfffd02ff, 0xfffd02ff, 0xfffd02ff, 0xfffd02ff, 0xfffd02ff, 0x00000000, 0x00000000, 0x00000000, 0xfffd02ff, 0xfffd02ff, 0xfffd02ff, 0xfffd02ff, 0xfffd02ff, 0xfffd02ff
+},
+{
+0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0xffffff00, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xffffff00, 0x00000000, 0x00000000, 0x00000000, 0xffffff00, 0x00000000, 0x00000000, 0x00000000, 0xffffff00, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xffffff00, 0x00000000, 0x00000000
+},
+{
+0x00000000, 0xff0878d3, 0xff0878d3, 0xff0878d3, 0x00000000, 0xff0878d3, 0x00000000, 0x00000000, 0x00000000, 0xff0878d3, 0x00000000, 0xff0878d3, 0xff0878d3, 0xff0878d3, 0x00000000, 0xff0878d3, 0x00000000, 0x00000000, 0x00000000, 0xff0878d3, 0x00000000, 0xff0878d3, 0xff0878d3, 0xff0878d3, 0x00000000
+},
+{
+0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x00000000, 0x00000000, 0x00000000, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0x00000000, 0x00000000, 0x00000000, 0x00000000, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff
+}
+};
@@ -1,65 +0,0 @@
-#include "extra\Desenho.h"
-
-int caixa_de_desenhos[10][ROWS][COLS][COLORS] = {
-
-    {{{254, 0, 0}, {254, 0, 0}, {254, 0, 0}, {254, 0, 0}, {254, 0, 0}},
-     {{254, 0, 0}, {0, 0, 0}, {0, 0, 0}, {254, 0, 0}, {254, 0, 0}},
-     {{254, 0, 0}, {0, 0, 0}, {254, 0, 0}, {0, 0, 0}, {254, 0, 0}},
-     {{254, 0, 0}, {254, 0, 0}, {0, 0, 0}, {0, 0, 0}, {254, 0, 0}},
-     {{254, 0, 0}, {254, 0, 0}, {254, 0, 0}, {254, 0, 0}, {254, 0, 0}}},
-
-    {{{0, 0, 0}, {0, 0, 0}, {0, 255, 0}, {0, 0, 0}, {0, 0, 0}},
-     {{0, 0, 0}, {0, 255, 0}, {0, 255, 0}, {0, 0, 0}, {0, 0, 0}},
-     {{0, 0, 0}, {0, 0, 0}, {0, 255, 0}, {0, 0, 0}, {0, 0, 0}},
-     {{0, 0, 0}, {0, 0, 0}, {0, 255, 0}, {0, 0, 0}, {0, 0, 0}},
-     {{0, 0, 0}, {0, 255, 0}, {0, 255, 0}, {0, 255, 0}, {0, 0, 0}}},
-
-    {{{0, 0, 255}, {0, 0, 255}, {0, 0, 255}, {0, 0, 255}, {0, 0, 0}},
-     {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 255}},
-     {{0, 0, 0}, {0, 0, 255}, {0, 0, 255}, {0, 0, 255}, {0, 0, 0}},
-     {{0, 0, 255}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}},
-     {{0, 0, 255}, {0, 0, 255}, {0, 0, 255}, {0, 0, 255}, {0, 0, 255}}},
-
-    {{{133, 0, 255}, {133, 0, 255}, {133, 0, 255}, {133, 0, 255}, {133, 0, 255}},
-     {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {133, 0, 255}},
-     {{0, 0, 0}, {133, 0, 255}, {133, 0, 255}, {133, 0, 255}, {0, 0, 0}},
-     {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {133, 0, 255}},
-     {{133, 0, 255}, {133, 0, 255}, {133, 0, 255}, {133, 0, 255}, {133, 0, 255}}},
-
-    {{{122, 255, 135}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}},
-     {{122, 255, 135}, {0, 0, 0}, {0, 0, 0}, {122, 255, 135}, {0, 0, 0}},
-     {{122, 255, 135}, {0, 0, 0}, {0, 0, 0}, {122, 255, 135}, {0, 0, 0}},
-     {{122, 255, 135}, {122, 255, 135}, {122, 255, 135}, {122, 255, 135}, {122, 255, 135}},
-     {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {122, 255, 135}, {0, 0, 0}}},
-
-    {{{255, 219, 0}, {255, 219, 0}, {255, 219, 0}, {255, 219, 0}, {255, 219, 0}},
-     {{255, 219, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}},
-     {{255, 219, 0}, {255, 219, 0}, {255, 219, 0}, {255, 219, 0}, {0, 0, 0}},
-     {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {255, 219, 0}},
-     {{255, 219, 0}, {255, 219, 0}, {255, 219, 0}, {255, 219, 0}, {0, 0, 0}}},
-
-    {{{255, 2, 253}, {255, 2, 253}, {255, 2, 253}, {255, 2, 253}, {255, 2, 253}},
-     {{255, 2, 253}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}},
-     {{255, 2, 253}, {255, 2, 253}, {255, 2, 253}, {255, 2, 253}, {255, 2, 253}},
-     {{255, 2, 253}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {255, 2, 253}},
-     {{255, 2, 253}, {255, 2, 253}, {255, 2, 253}, {255, 2, 253}, {255, 2, 253}}},
-
-    {{{0, 255, 255}, {0, 255, 255}, {0, 255, 255}, {0, 255, 255}, {0, 255, 255}},
-     {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 255, 255}},
-     {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 255, 255}, {0, 0, 0}},
-     {{0, 0, 0}, {0, 0, 0}, {0, 255, 255}, {0, 0, 0}, {0, 0, 0}},
-     {{0, 0, 0}, {0, 0, 0}, {0, 255, 255}, {0, 0, 0}, {0, 0, 0}}},
-
-    {{{0, 0, 0}, {211, 120, 8}, {211, 120, 8}, {211, 120, 8}, {0, 0, 0}},
-     {{211, 120, 8}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {211, 120, 8}},
-     {{0, 0, 0}, {211, 120, 8}, {211, 120, 8}, {211, 120, 8}, {0, 0, 0}},
-     {{211, 120, 8}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {211, 120, 8}},
-     {{0, 0, 0}, {211, 120, 8}, {211, 120, 8}, {211, 120, 8}, {0, 0, 0}}},
-
-    {{{255, 255, 255}, {255, 255, 255}, {255, 255, 255}, {255, 255, 255}, {255, 255, 255}},
-     {{255, 255, 255}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {255, 255, 255}},
-     {{255, 255, 255}, {255, 255, 255}, {255, 255, 255}, {255, 255, 255}, {255, 255, 255}},
-     {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {0, 0, 0}, {255, 255, 255}},
-     {{255, 255, 255}, {255, 255, 255}, {255, 255, 255}, {255, 255, 255}, {255, 255, 255}}},
-
-};
\ No newline at end of file
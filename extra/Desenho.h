@@ -1,11 +1,8 @@
 #ifndef DESENHO_H
 #define DESENHO_H
 
-#define ROWS 5
-#define COLS 5
-#define COLORS 3
+// Animações da matriz, geradas no build a partir dos exports do Piskel em
+// assets/ (ver add_piskel_asset no CMakeLists.txt)
+#include "assets/desenhos_numeros.h"
 
-
-extern int caixa_de_desenhos[10][ROWS][COLS][COLORS];
-
-#endif // DESENHO_H
\ No newline at end of file
+#endif // DESENHO_H
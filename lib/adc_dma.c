@@ -0,0 +1,123 @@
+#include "adc_dma.h"
+#include "hardware/adc.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+
+// O anel guarda as amostras na ordem em que o round robin as produz: índice
+// par = entrada 0, ímpar = entrada 1. O DMA escreve com wrap de endereço, por
+// isso o buffer é alinhado ao próprio tamanho.
+#define ADC_DMA_AMOSTRAS (ADC_DMA_PARES * ADC_DMA_CANAIS)
+#define ADC_DMA_MASCARA (ADC_DMA_AMOSTRAS - 1)
+#define ADC_DMA_BITS_ANEL 9 // 2^9 bytes = ADC_DMA_AMOSTRAS amostras de 16 bits
+
+// Transferências por disparo do DMA, múltiplo do anel. Perto de 3 dias a 2 kHz
+// por canal; no fim a interrupção só rearma o canal.
+#define ADC_DMA_CONTAGEM 0x40000000u
+
+static uint16_t adc_dma_anel[ADC_DMA_AMOSTRAS] __attribute__((aligned(ADC_DMA_AMOSTRAS * sizeof(uint16_t))));
+_Static_assert(sizeof(adc_dma_anel) == (1u << ADC_DMA_BITS_ANEL), "ADC_DMA_BITS_ANEL não corresponde a ADC_DMA_PARES");
+static int adc_dma_canal;
+static volatile uint32_t adc_dma_rearmes;
+
+static void adc_dma_irq_handler(void)
+{
+    if (!dma_channel_get_irq1_status(adc_dma_canal))
+        return;
+    dma_channel_acknowledge_irq1(adc_dma_canal);
+
+    ++adc_dma_rearmes;
+    dma_channel_set_trans_count(adc_dma_canal, ADC_DMA_CONTAGEM, true);
+}
+
+// Começa a amostrar as duas entradas a 'taxa_hz' cada uma. Os pinos já devem
+// estar configurados com adc_gpio_init.
+void adc_dma_iniciar(uint32_t taxa_hz)
+{
+    adc_run(false);
+    adc_select_input(0); // O round robin começa na entrada 0 (índice par)
+    adc_set_round_robin((1u << ADC_DMA_CANAIS) - 1);
+    adc_fifo_setup(true,  // Resultados vão para o FIFO
+                   true,  // DREQ para o DMA
+                   1,     // Pedido a cada amostra
+                   false, // Sem bit de erro na amostra
+                   false  // 12 bits, sem deslocar para 8
+    );
+    // Uma conversão a cada (1 + div) ciclos do clock do ADC (48 MHz), e o
+    // round robin divide as conversões entre as entradas
+    adc_set_clkdiv((float)clock_get_hz(clk_adc) / (taxa_hz * ADC_DMA_CANAIS) - 1.0f);
+    adc_fifo_drain();
+
+    adc_dma_canal = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(adc_dma_canal);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, ADC_DMA_BITS_ANEL);
+    channel_config_set_dreq(&c, DREQ_ADC);
+    dma_channel_configure(adc_dma_canal, &c, adc_dma_anel, &adc_hw->fifo, ADC_DMA_CONTAGEM, true);
+
+    irq_add_shared_handler(DMA_IRQ_1, adc_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    dma_channel_set_irq1_enabled(adc_dma_canal, true);
+    irq_set_enabled(DMA_IRQ_1, true);
+
+    adc_run(true);
+}
+
+// Amostras completas por canal desde o início (contador livre de 32 bits: a
+// diferença entre duas leituras diz quantas chegaram nesse intervalo)
+uint32_t adc_dma_amostras(void)
+{
+    uint32_t rearmes, restantes;
+    do
+    {
+        rearmes = adc_dma_rearmes;
+        restantes = dma_channel_hw_addr(adc_dma_canal)->transfer_count;
+    } while (rearmes != adc_dma_rearmes);
+
+    return rearmes * (ADC_DMA_CONTAGEM / ADC_DMA_CANAIS) + (ADC_DMA_CONTAGEM - restantes) / ADC_DMA_CANAIS;
+}
+
+// Amostra mais recente do canal (0 antes da primeira conversão)
+uint16_t adc_dma_ultimo(uint canal)
+{
+    uint32_t pares = adc_dma_amostras();
+    if (pares == 0)
+        return 0;
+    return adc_dma_anel[((pares - 1) * ADC_DMA_CANAIS + canal) & ADC_DMA_MASCARA];
+}
+
+// Copia as n amostras mais recentes do canal, da mais antiga para a mais nova.
+// Retorna quantas foram copiadas (no máximo ADC_DMA_BLOCO_MAX).
+size_t adc_dma_bloco(uint canal, uint16_t *destino, size_t n)
+{
+    uint32_t pares = adc_dma_amostras();
+    if (n > ADC_DMA_BLOCO_MAX)
+        n = ADC_DMA_BLOCO_MAX;
+    if (n > pares)
+        n = pares;
+
+    uint32_t indice = (pares - n) * ADC_DMA_CANAIS + canal;
+    for (size_t i = 0; i < n; ++i, indice += ADC_DMA_CANAIS)
+        destino[i] = adc_dma_anel[indice & ADC_DMA_MASCARA];
+    return n;
+}
+
+// Copia as amostras do canal que chegaram desde *posicao (um valor anterior de
+// adc_dma_amostras) e avança *posicao. Com mais atraso que 'max' ou
+// ADC_DMA_BLOCO_MAX, as mais antigas são descartadas.
+size_t adc_dma_novas(uint canal, uint32_t *posicao, uint16_t *destino, size_t max)
+{
+    uint32_t pares = adc_dma_amostras();
+    uint32_t n = pares - *posicao;
+    if (n > ADC_DMA_BLOCO_MAX)
+        n = ADC_DMA_BLOCO_MAX;
+    if (n > max)
+        n = max;
+    *posicao = pares;
+
+    uint32_t indice = (pares - n) * ADC_DMA_CANAIS + canal;
+    for (uint32_t i = 0; i < n; ++i, indice += ADC_DMA_CANAIS)
+        destino[i] = adc_dma_anel[indice & ADC_DMA_MASCARA];
+    return n;
+}
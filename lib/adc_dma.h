@@ -0,0 +1,26 @@
+#ifndef ADC_DMA_H
+#define ADC_DMA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "pico/stdlib.h"
+
+// Amostragem contínua das entradas 0 e 1 do ADC (joystick: 0 = y, 1 = x) em
+// round robin, a uma taxa fixa. O DMA esvazia o FIFO num buffer circular, sem
+// a CPU, então a amostragem não depende mais do tempo de cada volta do laço.
+#define ADC_DMA_CANAIS 2
+#define ADC_DMA_CANAL_Y 0
+#define ADC_DMA_CANAL_X 1
+
+// Amostras por canal no anel (potência de 2). Só a metade mais recente pode
+// ser lida em bloco: a outra metade é a folga para o DMA não alcançar a leitura.
+#define ADC_DMA_PARES 128
+#define ADC_DMA_BLOCO_MAX (ADC_DMA_PARES / 2)
+
+void adc_dma_iniciar(uint32_t taxa_hz);
+uint32_t adc_dma_amostras(void);
+uint16_t adc_dma_ultimo(uint canal);
+size_t adc_dma_bloco(uint canal, uint16_t *destino, size_t n);
+size_t adc_dma_novas(uint canal, uint32_t *posicao, uint16_t *destino, size_t max);
+
+#endif // ADC_DMA_H
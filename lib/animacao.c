@@ -0,0 +1,186 @@
+#include "animacao.h"
+#include "pico/stdlib.h"
+#include "hardware/sync.h"
+#include <string.h>
+
+static repeating_timer_t anim_timer;
+static volatile animacao_estado_t anim_estado = ANIMACAO_PARADA;
+static const frame_pack_t *anim_pack;
+static bool anim_repetir;
+static uint16_t anim_fade_ms;
+static uint8_t anim_quadro;      // Quadro atual
+static uint32_t anim_tempo_ms;   // Tempo decorrido no quadro atual
+static uint16_t anim_passos;     // Ticks restantes do cross-fade
+static bool anim_pendente;       // Há mudança ainda não enviada à matriz
+static volatile uint32_t anim_ticks; // Ticks do timer ainda não processados
+
+static npLED_t anim_alvo[LED_COUNT];       // Quadro decodificado (destino do fade)
+static uint16_t anim_atual[LED_COUNT][3];  // Cor exibida em 8.8 (R, G, B)
+static int32_t anim_passo[LED_COUNT][3];   // Incremento por tick em 8.8
+
+// Decodifica o quadro em anim_alvo e prepara a transição até ele
+static void anim_entrar_quadro(uint8_t quadro)
+{
+    anim_quadro = quadro;
+    anim_tempo_ms = 0;
+    fp_decodificar_quadro(anim_pack, quadro, anim_alvo);
+
+    uint16_t duracao = anim_pack->quadros[quadro].duracao_ms;
+    uint16_t fade = anim_fade_ms < duracao ? anim_fade_ms : duracao;
+    anim_passos = fade / ANIMACAO_TICK_MS;
+
+    for (uint i = 0; i < LED_COUNT; ++i)
+    {
+        const uint8_t alvo[3] = {anim_alvo[i].R, anim_alvo[i].G, anim_alvo[i].B};
+        for (uint c = 0; c < 3; ++c)
+        {
+            if (anim_passos)
+                anim_passo[i][c] = ((int32_t)(alvo[c] << 8) - anim_atual[i][c]) / anim_passos;
+            else
+                anim_atual[i][c] = alvo[c] << 8;
+        }
+    }
+    anim_pendente = true;
+}
+
+// Um passo do cross-fade; no último passo a cor vai exatamente para o alvo
+static void anim_passo_fade(void)
+{
+    --anim_passos;
+    for (uint i = 0; i < LED_COUNT; ++i)
+    {
+        if (anim_passos)
+        {
+            anim_atual[i][0] += anim_passo[i][0];
+            anim_atual[i][1] += anim_passo[i][1];
+            anim_atual[i][2] += anim_passo[i][2];
+        }
+        else
+        {
+            anim_atual[i][0] = anim_alvo[i].R << 8;
+            anim_atual[i][1] = anim_alvo[i].G << 8;
+            anim_atual[i][2] = anim_alvo[i].B << 8;
+        }
+    }
+    anim_pendente = true;
+}
+
+// Copia a cor atual para 'leds' e dispara o envio. Se a matriz ainda está
+// ocupada com o quadro anterior, o envio fica para o próximo tick.
+static void anim_enviar(void)
+{
+    if (!anim_pendente || npOcupado())
+        return;
+
+    for (uint i = 0; i < LED_COUNT; ++i)
+        npSetLED(i, anim_atual[i][0] >> 8, anim_atual[i][1] >> 8, anim_atual[i][2] >> 8);
+    npWrite();
+    anim_pendente = false;
+}
+
+// Interrupção do timer: só conta o tick. Decodificar quadros e escrever na
+// matriz (npSetLED/npWrite) fica para animacao_atualizar, no laço principal,
+// para não disputar 'leds' e o envio com o código de fora da interrupção.
+static bool anim_tick(repeating_timer_t *timer)
+{
+    if (anim_estado == ANIMACAO_TOCANDO)
+        ++anim_ticks;
+    return true;
+}
+
+// Avança a linha do tempo um tick; false quando a animação terminou
+static bool anim_avancar(void)
+{
+    anim_tempo_ms += ANIMACAO_TICK_MS;
+    if (anim_tempo_ms >= anim_pack->quadros[anim_quadro].duracao_ms)
+    {
+        uint8_t proximo = anim_quadro + 1;
+        if (proximo >= anim_pack->num_quadros)
+        {
+            if (!anim_repetir)
+                return false; // Último quadro fica aceso
+            proximo = 0;
+        }
+        anim_entrar_quadro(proximo);
+    }
+    else if (anim_passos)
+    {
+        anim_passo_fade();
+    }
+    return true;
+}
+
+// Chamada a cada volta do laço principal: consome os ticks acumulados pelo
+// timer (todos, se o laço atrasou) e envia o resultado à matriz. Um envio
+// adiado por a matriz estar ocupada é tentado de novo na volta seguinte.
+void animacao_atualizar(void)
+{
+    uint32_t estado_irq = save_and_disable_interrupts();
+    uint32_t ticks = anim_ticks;
+    anim_ticks = 0;
+    restore_interrupts(estado_irq);
+
+    while (ticks-- && anim_estado == ANIMACAO_TOCANDO)
+    {
+        if (!anim_avancar())
+        {
+            cancel_repeating_timer(&anim_timer);
+            anim_estado = ANIMACAO_PARADA;
+        }
+    }
+    anim_enviar();
+}
+
+// Começa a tocar o pack a partir do primeiro quadro. Com fade_ms > 0 cada
+// troca de quadro (inclusive a primeira, a partir do que está na matriz) é
+// um cross-fade linear de até fade_ms.
+void animacao_tocar(const frame_pack_t *pack, bool repetir, uint16_t fade_ms)
+{
+    animacao_parar();
+    if (pack->num_quadros == 0)
+        return;
+
+    anim_pack = pack;
+    anim_repetir = repetir;
+    anim_fade_ms = fade_ms;
+    for (uint i = 0; i < LED_COUNT; ++i)
+    {
+        anim_atual[i][0] = leds[i].R << 8;
+        anim_atual[i][1] = leds[i].G << 8;
+        anim_atual[i][2] = leds[i].B << 8;
+    }
+    memcpy(anim_alvo, leds, sizeof(anim_alvo));
+
+    anim_entrar_quadro(0);
+    anim_ticks = 0;
+    anim_estado = ANIMACAO_TOCANDO;
+    anim_enviar(); // Sem fade, o quadro 0 aparece imediatamente
+
+    // Intervalo negativo: ticks em ritmo fixo, medidos entre inícios de callback
+    add_repeating_timer_ms(-ANIMACAO_TICK_MS, anim_tick, NULL, &anim_timer);
+}
+
+void animacao_pausar(void)
+{
+    if (anim_estado == ANIMACAO_TOCANDO)
+        anim_estado = ANIMACAO_PAUSADA;
+}
+
+void animacao_retomar(void)
+{
+    if (anim_estado == ANIMACAO_PAUSADA)
+        anim_estado = ANIMACAO_TOCANDO;
+}
+
+void animacao_parar(void)
+{
+    if (anim_estado != ANIMACAO_PARADA)
+        cancel_repeating_timer(&anim_timer);
+    anim_estado = ANIMACAO_PARADA;
+    anim_pendente = false; // Quem parou assume a matriz; nada atrasado é enviado por cima
+}
+
+animacao_estado_t animacao_estado(void)
+{
+    return anim_estado;
+}
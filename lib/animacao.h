@@ -0,0 +1,30 @@
+#ifndef ANIMACAO_H
+#define ANIMACAO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "framepack.h"
+
+// Player de animações não bloqueante para a matriz de LEDs. Um timer
+// repetitivo marca os ticks; animacao_atualizar, chamada no laço principal,
+// avança a linha do tempo do frame pack (duração por quadro) e, opcionalmente,
+// faz um cross-fade linear entre quadros, calculado de forma incremental a
+// cada tick. O laço principal continua livre enquanto toca.
+
+#define ANIMACAO_TICK_MS 20
+
+typedef enum
+{
+    ANIMACAO_PARADA = 0,
+    ANIMACAO_TOCANDO,
+    ANIMACAO_PAUSADA,
+} animacao_estado_t;
+
+void animacao_tocar(const frame_pack_t *pack, bool repetir, uint16_t fade_ms);
+void animacao_pausar(void);
+void animacao_retomar(void);
+void animacao_parar(void);
+void animacao_atualizar(void);
+animacao_estado_t animacao_estado(void);
+
+#endif // ANIMACAO_H
@@ -1,21 +1,54 @@
 #include "buzzer.h"
+#include "melodia.h"
+#include "assets/tema_mario_kart.h"
 #include <stdlib.h>
 #include "hardware/pwm.h"
 #include "hardware/gpio.h"
-#include "buzzer.h"
+#include "hardware/sync.h"
 
 // Slices PWM usados pelos buzzers
 static uint slice_buzzer1;
 static uint slice_buzzer2;
 
+#define BUZZER_PAUSA_MS 30 // Pequena pausa entre notas
+
+// Sequenciador: uma fila de músicas tocadas a partir de um único alarme, que
+// reprograma o PWM a cada fronteira de nota e reagenda a si mesmo. Cada voz
+// guarda o instante absoluto do seu próximo evento; o alarme sempre dispara no
+// menor deles, então as vozes compartilham a mesma base de tempo e não se
+// afastam, por mais longa que seja a música.
+#define BUZZER_FILA_MAX 4
+
 typedef struct
 {
-    uint16_t frequency;
-    uint16_t duration_ms;
-} note_t;
+    trilha_t trilhas[BUZZER_VOZES];
+    uint8_t num_trilhas;
+    bool repetir;
+} buzzer_entrada_t;
+
+typedef struct
+{
+    size_t nota_atual;
+    melodia_leitor_t leitor; // Trilhas no formato compacto
+    uint8_t ultima_nota;
+    uint16_t pausa_ms;       // Silêncio depois da última nota
+    bool em_pausa;           // Entre o fim da nota e a próxima
+    bool ativa;
+    uint64_t proximo_us;     // Instante absoluto do próximo evento
+} buzzer_voz_t;
+
+static buzzer_entrada_t fila[BUZZER_FILA_MAX];
+static uint8_t fila_inicio;
+static uint8_t fila_tamanho;
+static buzzer_voz_t vozes[BUZZER_VOZES];
+static uint64_t alvo_us;          // Instante para o qual o alarme foi agendado
+static alarm_id_t alarme_sequenciador;
+static volatile bool tocando = false;
+static void (*callback_fim)(void) = NULL;
 
-// Protótipo da função usada antes da definição
+// Protótipos das funções usadas antes da definição
 void turn_off_buzzer(uint8_t buzzer);
+static void buzzer_aplicar_tom(uint8_t buzzer, const tom_pwm_t *tom);
 
 void buzzer_init(void)
 {
@@ -29,8 +62,8 @@ void buzzer_init(void)
 
     // Configurar PWM
     pwm_config config = pwm_get_default_config();
-    pwm_config_set_clkdiv(&config, 1.0f); // Divisor de clock (frequência alta)
-    pwm_config_set_wrap(&config, 4095);   // Resolução de 12 bits (0-4095)
+    pwm_config_set_clkdiv_int(&config, BUZZER_DIV_REPOUSO); // Mesma configuração dos LEDs
+    pwm_config_set_wrap(&config, BUZZER_WRAP_REPOUSO);      // Resolução de 12 bits (0-4095)
 
     pwm_init(slice_buzzer1, &config, true);
     pwm_init(slice_buzzer2, &config, true);
@@ -42,14 +75,9 @@ void buzzer_init(void)
 
 void turn_off_buzzer(uint8_t buzzer)
 {
-    if (buzzer == 1)
-    {
-        pwm_set_gpio_level(BUZZER_PIN_1, 0);
-    }
-    else if (buzzer == 2)
-    {
-        pwm_set_gpio_level(BUZZER_PIN_2, 0);
-    }
+    // Silêncio também devolve o slice à configuração de repouso
+    if (buzzer == 1 || buzzer == 2)
+        buzzer_aplicar_tom(buzzer, NULL);
 }
 
 void potencia_buzzer(uint8_t buzzer, float dutycicle)
@@ -74,63 +102,333 @@ void potencia_buzzer(uint8_t buzzer, float dutycicle)
     }
 }
 
+// Divisor e wrap de cada nota MIDI para BUZZER_CLOCK_HZ, calculados na compilação
+#define TOM_8(n) TOM_PWM_NOTA(n), TOM_PWM_NOTA(n + 1), TOM_PWM_NOTA(n + 2), TOM_PWM_NOTA(n + 3), \
+                 TOM_PWM_NOTA(n + 4), TOM_PWM_NOTA(n + 5), TOM_PWM_NOTA(n + 6), TOM_PWM_NOTA(n + 7)
+static const tom_pwm_t tabela_notas[128] = {
+    TOM_8(0), TOM_8(8), TOM_8(16), TOM_8(24), TOM_8(32), TOM_8(40), TOM_8(48), TOM_8(56),
+    TOM_8(64), TOM_8(72), TOM_8(80), TOM_8(88), TOM_8(96), TOM_8(104), TOM_8(112), TOM_8(120),
+};
+
+// Mesma escolha da tabela, em tempo de execução, para uma frequência qualquer
+// em mHz: menor divisor (em 1/16) que deixa o wrap caber em 16 bits e wrap
+// arredondado para o valor mais próximo
+void buzzer_calcular_tom(uint32_t clock_hz, uint32_t frequency_mhz, tom_pwm_t *tom)
+{
+    uint64_t numerador = (uint64_t)clock_hz * 16u * 1000u;
+    uint64_t frequency = frequency_mhz ? frequency_mhz : 1;
+    uint64_t div16 = (numerador + frequency * 65536u - 1) / (frequency * 65536u);
+    if (div16 < 16)
+        div16 = 16;
+    if (div16 > 4095)
+        div16 = 4095;
+
+    uint64_t topo = (numerador + frequency * div16 / 2) / (frequency * div16);
+    tom->div_int = div16 >> 4;
+    tom->div_frac = div16 & 15;
+    tom->wrap = topo > 65536 ? 65535 : topo - 1;
+}
+
+// Troca divisor e wrap do slice de 'pin' sem mudar o duty do outro canal: o
+// nível dele volta à escala do repouso (12 bits) e é levado ao novo wrap. Como
+// o wrap de toda nota MIDI passa de BUZZER_WRAP_REPOUSO, a ida e a volta são
+// exatas e o LED verde não deriva de uma nota para a outra.
+static void buzzer_configurar_slice(uint pin, uint8_t div_int, uint8_t div_frac, uint16_t wrap)
+{
+    const uint32_t escala = BUZZER_WRAP_REPOUSO + 1u;
+    uint slice = pwm_gpio_to_slice_num(pin);
+    uint outro = pwm_gpio_to_channel(pin) == PWM_CHAN_A ? PWM_CHAN_B : PWM_CHAN_A;
+
+    // Sem interrupções: o motor de efeitos dos LEDs escreve no mesmo slice
+    uint32_t estado = save_and_disable_interrupts();
+    uint32_t topo = pwm_hw->slice[slice].top + 1u;
+    uint32_t cc = pwm_hw->slice[slice].cc;
+    uint32_t nivel = outro == PWM_CHAN_A ? (cc & 0xFFFF) : (cc >> 16);
+    uint32_t nivel12 = (nivel * escala + topo / 2) / topo;
+
+    pwm_set_clkdiv_int_frac(slice, div_int, div_frac);
+    pwm_set_wrap(slice, wrap);
+    pwm_set_chan_level(slice, outro, (nivel12 * (wrap + 1u) + escala / 2) / escala);
+    restore_interrupts(estado);
+}
+
+// Aplica o tom ao slice do buzzer com 50% de duty (NULL = silêncio, com o
+// slice de volta à configuração de repouso)
+static void buzzer_aplicar_tom(uint8_t buzzer, const tom_pwm_t *tom)
+{
+    uint pin = (buzzer == 1) ? BUZZER_PIN_1 : BUZZER_PIN_2;
+
+    if (!tom)
+    {
+        pwm_set_gpio_level(pin, 0);
+        buzzer_configurar_slice(pin, BUZZER_DIV_REPOUSO, 0, BUZZER_WRAP_REPOUSO);
+        return;
+    }
+
+    buzzer_configurar_slice(pin, tom->div_int, tom->div_frac, tom->wrap);
+    pwm_set_gpio_level(pin, (tom->wrap + 1u) / 2); // 50% duty
+}
+
+// Toca uma nota MIDI: só consulta a tabela, a menos que o clock tenha mudado
+static void buzzer_tom_nota(uint8_t buzzer, uint8_t nota)
+{
+    if (nota == PAUSA || nota > 127)
+    {
+        buzzer_aplicar_tom(buzzer, NULL);
+        return;
+    }
+
+    uint32_t clock = clock_get_hz(clk_sys);
+    if (clock == BUZZER_CLOCK_HZ)
+    {
+        buzzer_aplicar_tom(buzzer, &tabela_notas[nota]);
+        return;
+    }
+
+    tom_pwm_t tom;
+    buzzer_calcular_tom(clock, (uint32_t)(NOTA_FREQ(nota) / 1024u), &tom);
+    buzzer_aplicar_tom(buzzer, &tom);
+}
+
+// Versão bloqueante, para uso fora do sequenciador
 void play_note(uint8_t buzzer, uint16_t frequency, uint16_t duration_ms)
 {
     if (frequency == 0)
     {
-        potencia_buzzer(buzzer, 0); // Silêncio
+        buzzer_aplicar_tom(buzzer, NULL); // Silêncio
         sleep_ms(duration_ms);
         return;
     }
 
-    uint slice = (buzzer == 1) ? slice_buzzer1 : slice_buzzer2;
-    uint pin = (buzzer == 1) ? BUZZER_PIN_1 : BUZZER_PIN_2;
+    tom_pwm_t tom;
+    buzzer_calcular_tom(clock_get_hz(clk_sys), frequency * 1000u, &tom);
+    buzzer_aplicar_tom(buzzer, &tom);
+    sleep_ms(duration_ms);
+    buzzer_aplicar_tom(buzzer, NULL); // Desliga som após nota
+    sleep_ms(BUZZER_PAUSA_MS);        // Pequena pausa entre notas
+}
 
-    uint32_t clock = clock_get_hz(clk_sys);
-    uint32_t top = clock / (frequency * 2);
-    if (top == 0)
-        top = 1;
+// Começa a entrada do início da fila com todas as vozes no instante 'inicio'
+static void buzzer_iniciar_vozes(uint64_t inicio)
+{
+    const buzzer_entrada_t *entrada = &fila[fila_inicio];
+    for (uint v = 0; v < BUZZER_VOZES; ++v)
+    {
+        buzzer_voz_t *voz = &vozes[v];
+        voz->nota_atual = 0;
+        voz->ultima_nota = PAUSA;
+        voz->em_pausa = false;
+        voz->ativa = v < entrada->num_trilhas;
+        voz->proximo_us = inicio;
+        if (voz->ativa && entrada->trilhas[v].melodia)
+            melodia_iniciar(&voz->leitor, entrada->trilhas[v].melodia);
+    }
+}
 
-    pwm_set_wrap(slice, top);
-    pwm_set_gpio_level(pin, top / 2); // 50% duty
-    sleep_ms(duration_ms);
-    pwm_set_gpio_level(pin, 0); // Desliga som após nota
-    sleep_ms(30);               // Pequena pausa entre notas
+// Evento de uma voz no instante 'agora': fim de nota (pausa curta) ou início da
+// próxima nota. Retorna false quando a trilha acabou.
+static bool buzzer_evento_voz(buzzer_voz_t *voz, const trilha_t *trilha, uint64_t agora)
+{
+    if (!voz->em_pausa && voz->ultima_nota != PAUSA && voz->pausa_ms)
+    {
+        buzzer_aplicar_tom(trilha->buzzer, NULL);
+        voz->em_pausa = true;
+        voz->proximo_us = agora + voz->pausa_ms * 1000u;
+        return true;
+    }
+    voz->em_pausa = false;
+
+    note_t nota;
+    voz->pausa_ms = BUZZER_PAUSA_MS;
+    if (trilha->melodia)
+    {
+        if (!melodia_proxima(&voz->leitor, &nota))
+            return false;
+
+        // No formato compacto a duração já é a do compasso: a pausa entre
+        // notas sai de dentro dela (no máximo um quarto da nota)
+        if (nota.note != PAUSA)
+        {
+            if (voz->pausa_ms > nota.duration_ms / 4)
+                voz->pausa_ms = nota.duration_ms / 4;
+            nota.duration_ms -= voz->pausa_ms;
+        }
+    }
+    else
+    {
+        if (voz->nota_atual >= trilha->num_notas)
+            return false;
+        nota = trilha->notas[voz->nota_atual++];
+    }
+
+    voz->ultima_nota = nota.note;
+    buzzer_tom_nota(trilha->buzzer, nota.note == PAUSA ? PAUSA : nota.note + trilha->transposicao);
+    voz->proximo_us = agora + (uint64_t)nota.duration_ms * 1000;
+    return true;
 }
 
-void play_mario_kart_theme(uint8_t buzzer)
+// Processa as vozes cujo evento chegou e devolve em quantos us o alarme deve
+// rodar de novo (0 = fila vazia). O reagendamento é relativo ao horário
+// previsto do alarme anterior, então os atrasos da interrupção não se acumulam.
+static int64_t buzzer_passo(alarm_id_t id, void *user_data)
+{
+    if (!tocando)
+        return 0;
+
+    for (;;)
+    {
+        const buzzer_entrada_t *entrada = &fila[fila_inicio];
+        uint64_t proximo = UINT64_MAX;
+
+        for (uint v = 0; v < entrada->num_trilhas; ++v)
+        {
+            buzzer_voz_t *voz = &vozes[v];
+            // Eventos de duração zero são processados na mesma passada
+            while (voz->ativa && voz->proximo_us <= alvo_us)
+                voz->ativa = buzzer_evento_voz(voz, &entrada->trilhas[v], alvo_us);
+            if (voz->ativa && voz->proximo_us < proximo)
+                proximo = voz->proximo_us;
+        }
+
+        if (proximo != UINT64_MAX)
+        {
+            int64_t espera = proximo - alvo_us;
+            alvo_us = proximo;
+            return espera;
+        }
+
+        // Todas as vozes terminaram juntas neste instante. Repete enquanto não
+        // houver outra música esperando na fila.
+        if (!(entrada->repetir && fila_tamanho == 1))
+        {
+            fila_inicio = (fila_inicio + 1) % BUZZER_FILA_MAX;
+            --fila_tamanho;
+            if (fila_tamanho == 0)
+            {
+                tocando = false;
+                if (callback_fim)
+                    callback_fim();
+                return 0;
+            }
+        }
+        buzzer_iniciar_vozes(alvo_us);
+    }
+}
+
+// Coloca uma música de uma ou mais trilhas na fila e retorna na hora; false se
+// a fila estiver cheia. As notas precisam continuar válidas até tocarem (de
+// preferência const, na flash).
+bool buzzer_tocar_musica(const musica_t *musica, bool repetir)
+{
+    if (musica->num_trilhas == 0)
+        return true;
+
+    buzzer_entrada_t entrada = {.num_trilhas = musica->num_trilhas, .repetir = repetir};
+    if (entrada.num_trilhas > BUZZER_VOZES)
+        entrada.num_trilhas = BUZZER_VOZES;
+    for (uint t = 0; t < entrada.num_trilhas; ++t)
+        entrada.trilhas[t] = musica->trilhas[t];
+
+    uint32_t estado = save_and_disable_interrupts();
+    if (fila_tamanho >= BUZZER_FILA_MAX)
+    {
+        restore_interrupts(estado);
+        return false;
+    }
+
+    fila[(fila_inicio + fila_tamanho) % BUZZER_FILA_MAX] = entrada;
+    ++fila_tamanho;
+    bool iniciar = !tocando;
+    if (iniciar)
+    {
+        tocando = true;
+        alvo_us = time_us_64() + 100;
+        buzzer_iniciar_vozes(alvo_us);
+        alarme_sequenciador = add_alarm_at(from_us_since_boot(alvo_us), buzzer_passo, NULL, true);
+    }
+    restore_interrupts(estado);
+
+    if (iniciar && alarme_sequenciador < 0)
+    {
+        buzzer_parar(); // Sem alarmes livres
+        return false;
+    }
+    return true;
+}
+
+// Atalho para uma melodia de uma voz só
+bool buzzer_tocar(uint8_t buzzer, const note_t *notas, size_t num_notas, bool repetir)
+{
+    const trilha_t trilha = {buzzer, notas, num_notas, 0, NULL};
+    const musica_t musica = {1, &trilha};
+    return buzzer_tocar_musica(&musica, repetir);
+}
+
+// Atalho para uma melodia de uma voz no formato compacto
+bool buzzer_tocar_melodia(uint8_t buzzer, const uint8_t *melodia, bool repetir)
+{
+    const trilha_t trilha = {buzzer, NULL, 0, 0, melodia};
+    const musica_t musica = {1, &trilha};
+    return buzzer_tocar_musica(&musica, repetir);
+}
+
+// Asset com várias trilhas (lib/melodia.h): a trilha k toca no buzzer k + 1,
+// todas pela mesma base de tempo do sequenciador. Trilhas além de
+// BUZZER_VOZES são ignoradas.
+bool buzzer_tocar_trilhas(const uint8_t *melodia, bool repetir)
+{
+    trilha_t trilhas[BUZZER_VOZES];
+    uint8_t num_trilhas = melodia_num_trilhas(melodia);
+    if (num_trilhas > BUZZER_VOZES)
+        num_trilhas = BUZZER_VOZES;
+    for (uint8_t t = 0; t < num_trilhas; ++t)
+        trilhas[t] = (trilha_t){t + 1, NULL, 0, 0, melodia_trilha(melodia, t)};
+
+    const musica_t musica = {num_trilhas, trilhas};
+    return buzzer_tocar_musica(&musica, repetir);
+}
+
+// Interrompe a música atual e esvazia a fila (o callback de fim não é chamado)
+void buzzer_parar(void)
 {
+    uint32_t estado = save_and_disable_interrupts();
+    bool estava_tocando = tocando;
+    tocando = false;
+    fila_tamanho = 0;
+    if (estava_tocando && alarme_sequenciador > 0)
+        cancel_alarm(alarme_sequenciador);
+    restore_interrupts(estado);
 
-    const note_t melody[] = {
-        {659, 150}, {659, 150}, {0, 100}, {659, 150}, {0, 100}, {523, 150}, {659, 150}, {0, 150}, {784, 150}, {0, 300}, {392, 150}, {0, 150},
-
-        {523, 150},
-        {0, 150},
-        {392, 150},
-        {0, 150},
-        {330, 150},
-        {0, 150},
-        {440, 150},
-        {0, 150},
-        {494, 150},
-        {0, 150},
-        {466, 150},
-        {0, 150},
-        {440, 150},
-        {0, 150},
-        {392, 150},
-        {659, 150},
-        {784, 150},
-        {0, 150},
-        {880, 150},
-        {0, 300}};
-
-    const size_t melody_length = sizeof(melody) / sizeof(note_t);
-
-    for (size_t i = 0; i < melody_length; ++i)
+    if (estava_tocando)
     {
-        play_note(buzzer, melody[i].frequency, melody[i].duration_ms);
+        turn_off_buzzer(1);
+        turn_off_buzzer(2);
     }
+}
+
+bool buzzer_tocando(void)
+{
+    return tocando;
+}
+
+// Chamado (em contexto de interrupção) quando a fila termina
+void buzzer_set_callback(void (*callback)(void))
+{
+    callback_fim = callback;
+}
 
-    turn_off_buzzer(buzzer);
+// O tema fica em assets/mario_kart.rtttl (melodia e baixo, uma trilha por
+// linha) e é convertido no build para o formato compacto (tema_mario_kart,
+// na flash). Com um buzzer só toca a melodia.
+
+// Não bloqueia: a melodia toca pelo sequenciador enquanto o laço principal segue
+void play_mario_kart_theme(uint8_t buzzer)
+{
+    buzzer_tocar_melodia(buzzer, tema_mario_kart, false);
+}
+
+// Melodia (trilha 0) no buzzer 1 e o baixo (trilha 1) no buzzer 2
+void play_mario_kart_duas_vozes(void)
+{
+    buzzer_tocar_trilhas(tema_mario_kart, false);
 }
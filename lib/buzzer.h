@@ -4,16 +4,60 @@
 #include "pico/stdlib.h"
 #include "hardware/pwm.h"
 #include "hardware/clocks.h"
+#include "buzzer_notas.h"
 
 // Definição dos pinos dos buzzers
 #define BUZZER_PIN_1 10
 #define BUZZER_PIN_2 21
 
+// O buzzer 1 (GPIO 10, canal A) divide o slice PWM 5 com o LED verde (GPIO 11,
+// canal B), e os pinos são fixos na placa. Por isso, fora das notas, o slice
+// fica sempre na configuração dos LEDs (divisor 1, wrap 4095). Durante uma
+// nota, o nível do outro canal é reescalado para o wrap da nota, então o LED
+// mantém o duty. Quem escreve no outro canal com uma nota tocando faz a mesma
+// conta (ver led_aplicar_niveis em leds.c).
+#define BUZZER_DIV_REPOUSO 1
+#define BUZZER_WRAP_REPOUSO 4095
+
+// Música de várias trilhas: cada trilha toca em um buzzer, todas a partir da
+// mesma base de tempo. A transposição (em semitons) permite reaproveitar as
+// notas de uma trilha em outra voz, por exemplo uma oitava abaixo. Com
+// 'melodia' preenchido a trilha é lida do formato compacto (lib/melodia.h),
+// uma nota por vez, e 'notas'/'num_notas' são ignorados; num asset de várias
+// trilhas, 'melodia' aponta para uma delas (melodia_trilha).
+#define BUZZER_VOZES 2
+
+typedef struct
+{
+    uint8_t buzzer;
+    const note_t *notas;
+    size_t num_notas;
+    int8_t transposicao;
+    const uint8_t *melodia;
+} trilha_t;
+
+typedef struct
+{
+    uint8_t num_trilhas;
+    const trilha_t *trilhas;
+} musica_t;
+
 // Protótipos das funções
 void buzzer_init(void);
 void turn_off_buzzer(uint8_t buzzer);
 void potencia_buzzer(uint8_t buzzer, float dutycicle);
 void play_note(uint8_t buzzer, uint16_t frequency, uint16_t duration_ms);
+void buzzer_calcular_tom(uint32_t clock_hz, uint32_t frequency_mhz, tom_pwm_t *tom);
 void play_mario_kart_theme(uint8_t buzzer);
+void play_mario_kart_duas_vozes(void);
+
+// Sequenciador não bloqueante
+bool buzzer_tocar(uint8_t buzzer, const note_t *notas, size_t num_notas, bool repetir);
+bool buzzer_tocar_melodia(uint8_t buzzer, const uint8_t *melodia, bool repetir);
+bool buzzer_tocar_musica(const musica_t *musica, bool repetir);
+bool buzzer_tocar_trilhas(const uint8_t *melodia, bool repetir);
+void buzzer_parar(void);
+bool buzzer_tocando(void);
+void buzzer_set_callback(void (*callback)(void));
 
 #endif
\ No newline at end of file
@@ -0,0 +1,74 @@
+#ifndef BUZZER_NOTAS_H
+#define BUZZER_NOTAS_H
+
+#include <stdint.h>
+
+// Notas musicais como números MIDI (69 = Lá 4 = 440 Hz) e o cálculo, em tempo
+// de compilação, do divisor e do wrap do PWM que geram cada uma.
+//
+// f = clock / (divisor * (wrap + 1)), com divisor = inteiro + fração/16.
+// Para a melhor afinação o contador usa o maior wrap possível (até 65535):
+// o divisor é o menor que cabe e o wrap é arredondado para o valor mais
+// próximo. Com o clock padrão de 125 MHz o erro fica abaixo de 0,1 cent
+// (conferido para as 128 notas em testes/teste_notas.c, também a 133 MHz).
+
+#ifndef BUZZER_CLOCK_HZ
+#if defined(SYS_CLK_HZ)
+#define BUZZER_CLOCK_HZ SYS_CLK_HZ
+#elif defined(SYS_CLK_KHZ)
+#define BUZZER_CLOCK_HZ (SYS_CLK_KHZ * 1000)
+#else
+#define BUZZER_CLOCK_HZ 125000000
+#endif
+#endif
+
+#define NOTA_DO 0
+#define NOTA_DO_S 1
+#define NOTA_RE 2
+#define NOTA_RE_S 3
+#define NOTA_MI 4
+#define NOTA_FA 5
+#define NOTA_FA_S 6
+#define NOTA_SOL 7
+#define NOTA_SOL_S 8
+#define NOTA_LA 9
+#define NOTA_LA_S 10
+#define NOTA_SI 11
+
+#define PAUSA 0 // Nota 0 (8 Hz) não é usada em melodia: vale como silêncio
+#define NOTA(nome, oitava) (12 * ((oitava) + 1) + NOTA_##nome) // NOTA(LA, 4) = 69
+
+// Nota de melodia: número MIDI (PAUSA = silêncio)
+typedef struct
+{
+    uint8_t note;
+    uint16_t duration_ms;
+} note_t;
+
+// Frequências da oitava -1 (MIDI 0 a 11) em mHz/1024, ou seja, as da oitava 9
+// (MIDI 120 a 131) em mHz; as demais oitavas saem por deslocamento
+#define NOTA_BASE_MHZ(s)                                                 \
+    ((s) == 0 ? 8372018u : (s) == 1 ? 8869844u : (s) == 2 ? 9397273u    \
+   : (s) == 3 ? 9956063u : (s) == 4 ? 10548082u : (s) == 5 ? 11175303u  \
+   : (s) == 6 ? 11839822u : (s) == 7 ? 12543854u : (s) == 8 ? 13289750u \
+   : (s) == 9 ? 14080000u : (s) == 10 ? 14917240u : 15804264u)
+
+// Frequência da nota n em mHz/1024 (a escala mantém a precisão das oitavas baixas)
+#define NOTA_FREQ(n) ((uint64_t)NOTA_BASE_MHZ((n) % 12) << ((n) / 12))
+
+// Divisor em dezesseis avos para a frequência f (mHz/1024), limitado a 1.0 .. 255 + 15/16
+#define TOM_DIV16_BRUTO(f) (((uint64_t)BUZZER_CLOCK_HZ * 16u * 1000u * 1024u + (f) * 65536u - 1) / ((f) * 65536u))
+#define TOM_DIV16(f) (TOM_DIV16_BRUTO(f) < 16 ? 16 : TOM_DIV16_BRUTO(f) > 4095 ? 4095 : TOM_DIV16_BRUTO(f))
+#define TOM_TOPO_BRUTO(f) (((uint64_t)BUZZER_CLOCK_HZ * 16u * 1000u * 1024u + (f) * TOM_DIV16(f) / 2) / ((f) * TOM_DIV16(f)))
+#define TOM_WRAP(f) (TOM_TOPO_BRUTO(f) > 65536 ? 65535 : TOM_TOPO_BRUTO(f) - 1)
+
+typedef struct
+{
+    uint8_t div_int;
+    uint8_t div_frac; // Dezesseis avos
+    uint16_t wrap;
+} tom_pwm_t;
+
+#define TOM_PWM_NOTA(n) {TOM_DIV16(NOTA_FREQ(n)) >> 4, TOM_DIV16(NOTA_FREQ(n)) & 15, TOM_WRAP(NOTA_FREQ(n))}
+
+#endif // BUZZER_NOTAS_H
@@ -0,0 +1,34 @@
+#ifndef CICLOS_H
+#define CICLOS_H
+
+#include <stdint.h>
+#include "hardware/structs/systick.h"
+
+// Contador de ciclos da CPU para medições de desempenho, sobre o SysTick do
+// núcleo (24 bits, decrescente, no clock do processador). O SysTick é do
+// núcleo inteiro: só ciclos_iniciar o programa, e só quem mede chama. Até lá
+// as leituras de ciclos_agora (e as medidas feitas com elas) valem 0 ou lixo.
+// Intervalos de até 2^24 ciclos (134 ms a 125 MHz).
+
+#define CICLOS_MASCARA 0xFFFFFFu
+
+static inline void ciclos_iniciar(void)
+{
+    systick_hw->csr = 0;
+    systick_hw->rvr = CICLOS_MASCARA;
+    systick_hw->cvr = 0;
+    systick_hw->csr = 0x5; // Habilita, fonte = clock do processador, sem interrupção
+}
+
+static inline uint32_t ciclos_agora(void)
+{
+    return systick_hw->cvr;
+}
+
+// Ciclos passados desde uma leitura de ciclos_agora
+static inline uint32_t ciclos_desde(uint32_t inicio)
+{
+    return (inicio - systick_hw->cvr) & CICLOS_MASCARA;
+}
+
+#endif // CICLOS_H
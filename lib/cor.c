@@ -0,0 +1,160 @@
+#include "cor.h"
+#include <stdlib.h>
+
+// Canal entre p (mínimo) e v (máximo) por setor de 60 graus: v, subindo (t),
+// descendo (q) ou p
+#define COR_SETORES(V, P, Q, T, r, g, b)              \
+    switch (setor)                                    \
+    {                                                 \
+    case 0: r = V; g = T; b = P; break;               \
+    case 1: r = Q; g = V; b = P; break;               \
+    case 2: r = P; g = V; b = T; break;               \
+    case 3: r = P; g = Q; b = V; break;               \
+    case 4: r = T; g = P; b = V; break;               \
+    default: r = V; g = P; b = Q; break;              \
+    }
+
+// HSV para RGB de 8 bits. A fração do setor é f/256 e o erro em relação à
+// conta em ponto flutuante é de no máximo 1 em cada canal.
+npColor_t cor_hsv_para_rgb(cor_hsv_t hsv)
+{
+    uint32_t h = hsv.h < COR_MATIZ_VOLTA ? hsv.h : hsv.h % COR_MATIZ_VOLTA;
+    uint32_t setor = h >> 8, f = h & 0xFF;
+    uint32_t v = hsv.v;
+    uint32_t p = cor_div255(v * (255 - hsv.s));
+    uint32_t rampa = ((v - p) * f + 128) >> 8;
+    uint32_t q = v - rampa, t = p + rampa;
+
+    npColor_t cor;
+    COR_SETORES(v, p, q, t, cor.r, cor.g, cor.b);
+    return cor;
+}
+
+// Mesma conversão com saída de 16 bits e matiz com 16 bits de fração por setor
+// (0 .. 6 * 65536 - 1), para efeitos lentos que não podem andar em degraus
+void cor_hsv_para_rgb16(uint32_t matiz, uint8_t s, uint8_t v, uint16_t rgb[3])
+{
+    uint32_t setor = matiz >> 16, f = matiz & 0xFFFF;
+    uint32_t V = v * 257u;
+    uint32_t P = (v * (255u - s) * 257u + 127) / 255;
+    uint32_t rampa = ((V - P) * f + 32768) >> 16;
+    uint32_t Q = V - rampa, T = P + rampa;
+
+    COR_SETORES(V, P, Q, T, rgb[0], rgb[1], rgb[2]);
+}
+
+// RGB para HSV; converter de volta devolve a cor original a menos de 1 por
+// canal (a matiz tem 256 passos por setor)
+cor_hsv_t cor_rgb_para_hsv(npColor_t cor)
+{
+    int32_t r = cor.r, g = cor.g, b = cor.b;
+    int32_t max = r > g ? (r > b ? r : b) : (g > b ? g : b);
+    int32_t min = r < g ? (r < b ? r : b) : (g < b ? g : b);
+    int32_t delta = max - min;
+
+    cor_hsv_t hsv = {0, 0, max};
+    if (delta == 0)
+        return hsv; // Cinza: matiz indefinida
+
+    hsv.s = (255 * delta + max / 2) / max;
+
+    int32_t base, x;
+    if (max == r)
+    {
+        base = 0;
+        x = g - b;
+    }
+    else if (max == g)
+    {
+        base = 512;
+        x = b - r;
+    }
+    else
+    {
+        base = 1024;
+        x = r - g;
+    }
+    int32_t h = base + (256 * x + (x >= 0 ? delta / 2 : -delta / 2)) / delta;
+    hsv.h = h < 0 ? h + COR_MATIZ_VOLTA : h;
+    return hsv;
+}
+
+// Interpolação linear com t de 0 (a) a 256 (b)
+npColor_t cor_lerp(npColor_t a, npColor_t b, uint16_t t)
+{
+    uint32_t u = 256 - t;
+    return (npColor_t){(a.r * u + b.r * t + 128) >> 8,
+                       (a.g * u + b.g * t + 128) >> 8,
+                       (a.b * u + b.b * t + 128) >> 8};
+}
+
+// 'frente' sobre 'fundo' com opacidade alfa (255 = só a frente)
+npColor_t cor_misturar(npColor_t fundo, npColor_t frente, uint8_t alfa)
+{
+    uint32_t u = 255 - alfa;
+    return (npColor_t){cor_div255(fundo.r * u + frente.r * alfa),
+                       cor_div255(fundo.g * u + frente.g * alfa),
+                       cor_div255(fundo.b * u + frente.b * alfa)};
+}
+
+// Escala em 8.8 (256 = 1.0), a mesma convenção de npSetEscalaCanais
+npColor_t cor_escalar(npColor_t cor, uint16_t fator)
+{
+    if (fator > 256)
+        fator = 256;
+    return (npColor_t){(cor.r * fator + 128) >> 8, (cor.g * fator + 128) >> 8, (cor.b * fator + 128) >> 8};
+}
+
+// Matiz sorteada com saturação e valor máximos: cores vivas em vez da mistura
+// acinzentada de três canais sorteados
+npColor_t cor_aleatoria(void)
+{
+    return cor_hsv_para_rgb((cor_hsv_t){rand() % COR_MATIZ_VOLTA, 255, 255});
+}
+
+void cor_lerp_leds(npLED_t *destino, const npLED_t *a, const npLED_t *b, size_t n, uint16_t t)
+{
+    uint32_t u = 256 - t;
+    for (size_t i = 0; i < n; ++i)
+    {
+        destino[i].R = (a[i].R * u + b[i].R * t + 128) >> 8;
+        destino[i].G = (a[i].G * u + b[i].G * t + 128) >> 8;
+        destino[i].B = (a[i].B * u + b[i].B * t + 128) >> 8;
+    }
+}
+
+void cor_misturar_leds(npLED_t *leds_destino, size_t n, npColor_t cor, uint8_t alfa)
+{
+    // A parte da cor é a mesma para todos os pixels
+    uint32_t u = 255 - alfa;
+    uint32_t r = cor.r * alfa, g = cor.g * alfa, b = cor.b * alfa;
+    for (size_t i = 0; i < n; ++i)
+    {
+        leds_destino[i].R = cor_div255(leds_destino[i].R * u + r);
+        leds_destino[i].G = cor_div255(leds_destino[i].G * u + g);
+        leds_destino[i].B = cor_div255(leds_destino[i].B * u + b);
+    }
+}
+
+void cor_escalar_leds(npLED_t *leds_destino, size_t n, uint16_t fator)
+{
+    if (fator > 256)
+        fator = 256;
+    for (size_t i = 0; i < n; ++i)
+    {
+        leds_destino[i].R = (leds_destino[i].R * fator + 128) >> 8;
+        leds_destino[i].G = (leds_destino[i].G * fator + 128) >> 8;
+        leds_destino[i].B = (leds_destino[i].B * fator + 128) >> 8;
+    }
+}
+
+void cor_hsv_para_leds(npLED_t *destino, const cor_hsv_t *hsv, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        npColor_t cor = cor_hsv_para_rgb(hsv[i]);
+        destino[i].R = cor.r;
+        destino[i].G = cor.g;
+        destino[i].B = cor.b;
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef COR_H
+#define COR_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "matrizRGB.h"
+
+// Matemática de cor só com inteiros, usada pelo LED RGB e pela matriz.
+//
+// Matiz em 1/256 de setor: 0..COR_MATIZ_VOLTA-1, com vermelho em 0, verde em
+// 512 e azul em 1024. Saturação e valor de 0 a 255.
+#define COR_MATIZ_VOLTA 1536
+
+typedef struct
+{
+    uint16_t h;
+    uint8_t s, v;
+} cor_hsv_t;
+
+// Divisão por 255 arredondada, exata para 0 <= x <= 65535
+static inline uint32_t cor_div255(uint32_t x)
+{
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+npColor_t cor_hsv_para_rgb(cor_hsv_t hsv);
+cor_hsv_t cor_rgb_para_hsv(npColor_t cor);
+void cor_hsv_para_rgb16(uint32_t matiz, uint8_t s, uint8_t v, uint16_t rgb[3]);
+npColor_t cor_lerp(npColor_t a, npColor_t b, uint16_t t);
+npColor_t cor_misturar(npColor_t fundo, npColor_t frente, uint8_t alfa);
+npColor_t cor_escalar(npColor_t cor, uint16_t fator);
+npColor_t cor_aleatoria(void);
+
+// Versões em lote sobre buffers de LEDs (podem ser o próprio 'leds'; nesse
+// caso use os atalhos np* de matrizRGB.h, que mantêm a estimativa de corrente)
+void cor_lerp_leds(npLED_t *destino, const npLED_t *a, const npLED_t *b, size_t n, uint16_t t);
+void cor_misturar_leds(npLED_t *leds_destino, size_t n, npColor_t cor, uint8_t alfa);
+void cor_escalar_leds(npLED_t *leds_destino, size_t n, uint16_t fator);
+void cor_hsv_para_leds(npLED_t *destino, const cor_hsv_t *hsv, size_t n);
+
+#endif // COR_H
@@ -0,0 +1,159 @@
+#include "filtro_entrada.h"
+#include <string.h>
+
+#define FILTRO_MAXIMO (4095 << FILTRO_FRACAO)
+
+// Zona morta efetiva e fatores 2.14 que levam o que sobra depois dela de volta
+// à faixa toda. A zona não passa da metade do lado mais curto, então o
+// esticamento fica em no máximo 2.0 e sempre cabe nos fatores de 16 bits.
+static void filtro_ajustar_zona(filtro_t *filtro)
+{
+    int32_t acima = FILTRO_MAXIMO - filtro->centro;
+    int32_t abaixo = filtro->centro;
+    int32_t zona = filtro->cfg.zona_morta << FILTRO_FRACAO;
+    int32_t limite = (acima < abaixo ? acima : abaixo) / 2;
+
+    filtro->zona = zona < limite ? zona : limite;
+    filtro->fator_acima = acima > 0 ? ((acima << FILTRO_FATOR_BITS) + (acima - filtro->zona) / 2) / (acima - filtro->zona)
+                                    : 1 << FILTRO_FATOR_BITS;
+    filtro->fator_abaixo = abaixo > 0 ? ((abaixo << FILTRO_FATOR_BITS) + (abaixo - filtro->zona) / 2) / (abaixo - filtro->zona)
+                                      : 1 << FILTRO_FATOR_BITS;
+}
+
+void filtro_iniciar(filtro_t *filtro, const filtro_config_t *cfg)
+{
+    memset(filtro, 0, sizeof(*filtro));
+    filtro->cfg = *cfg;
+    if (filtro->cfg.mediana_n > FILTRO_MEDIANA_MAX)
+        filtro->cfg.mediana_n = FILTRO_MEDIANA_MAX;
+    filtro->cfg.mediana_n |= 1; // Janela ímpar
+    if (filtro->cfg.decimacao > 12)
+        filtro->cfg.decimacao = 12;
+
+    filtro->centro = 2048 << FILTRO_FRACAO; // Até filtro_calibrar_centro
+    filtro->saida = filtro->centro;
+    filtro_ajustar_zona(filtro);
+}
+
+// Mede o centro com a entrada em repouso (média do bloco). Uma média a mais de
+// FILTRO_CENTRO_DESVIO_MAX do meio da faixa (joystick fora do repouso, entrada
+// solta) não é um centro plausível: fica o nominal 2048 e retorna false.
+bool filtro_calibrar_centro(filtro_t *filtro, const uint16_t *amostras, size_t n)
+{
+    if (n == 0)
+        return false;
+
+    uint32_t soma = 0;
+    for (size_t i = 0; i < n; ++i)
+        soma += amostras[i];
+    int32_t centro = ((soma << FILTRO_FRACAO) + n / 2) / n;
+    int32_t desvio = centro - (2048 << FILTRO_FRACAO);
+    bool plausivel = desvio <= (FILTRO_CENTRO_DESVIO_MAX << FILTRO_FRACAO) &&
+                     desvio >= -(FILTRO_CENTRO_DESVIO_MAX << FILTRO_FRACAO);
+
+    filtro->centro = plausivel ? centro : 2048 << FILTRO_FRACAO;
+    if (!filtro->iniciado)
+        filtro->saida = filtro->centro; // Até a primeira saída do filtro
+    filtro_ajustar_zona(filtro);
+    return plausivel;
+}
+
+static int32_t filtro_mediana(filtro_t *filtro, int32_t x)
+{
+    uint8_t n = filtro->cfg.mediana_n;
+    filtro->janela[filtro->janela_pos] = x;
+    filtro->janela_pos = filtro->janela_pos + 1 < n ? filtro->janela_pos + 1 : 0;
+    if (filtro->janela_cheia < n)
+        ++filtro->janela_cheia;
+
+    // Ordenação por inserção de no máximo FILTRO_MEDIANA_MAX valores
+    uint16_t ordem[FILTRO_MEDIANA_MAX];
+    uint8_t m = filtro->janela_cheia;
+    for (uint8_t i = 0; i < m; ++i)
+    {
+        uint16_t v = filtro->janela[i];
+        uint8_t j = i;
+        for (; j > 0 && ordem[j - 1] > v; --j)
+            ordem[j] = ordem[j - 1];
+        ordem[j] = v;
+    }
+    return ordem[m / 2];
+}
+
+// Estágios 2 a 4 para uma saída da sobreamostragem (12 bits + fração)
+static void filtro_saida(filtro_t *filtro, int32_t x)
+{
+    if (filtro->cfg.tipo == FILTRO_IIR)
+    {
+        if (!filtro->iniciado)
+            filtro->iir = x << 8;
+        else
+            filtro->iir += ((x << 8) - filtro->iir) >> filtro->cfg.iir_shift;
+        x = (filtro->iir + 128) >> 8;
+    }
+    else if (filtro->cfg.tipo == FILTRO_MEDIANA)
+    {
+        x = filtro_mediana(filtro, x);
+    }
+
+    int32_t zona = filtro->zona;
+    int32_t d = x - filtro->centro;
+    if (d > zona)
+        x = filtro->centro + (((uint32_t)(d - zona) * filtro->fator_acima) >> FILTRO_FATOR_BITS);
+    else if (d < -zona)
+        x = filtro->centro - (((uint32_t)(-d - zona) * filtro->fator_abaixo) >> FILTRO_FATOR_BITS);
+    else
+        x = filtro->centro;
+
+    int32_t folga = filtro->cfg.histerese << FILTRO_FRACAO;
+    if (!filtro->iniciado)
+    {
+        filtro->saida = x;
+        filtro->iniciado = true;
+    }
+    else if (x > filtro->saida + folga)
+        filtro->saida = x - folga;
+    else if (x < filtro->saida - folga)
+        filtro->saida = x + folga;
+
+    // Nos trilhos a folga não se aplica: a entrada esticada não passa de 0 e
+    // 4095, então sem isso a saída pararia 'histerese' antes deles. Meia
+    // contagem de tolerância cobre o arredondamento dos fatores.
+    const int32_t meia = 1 << (FILTRO_FRACAO - 1);
+    if (x < meia)
+        filtro->saida = 0;
+    else if (x >= (4095 << FILTRO_FRACAO) - meia)
+        filtro->saida = 4095 << FILTRO_FRACAO;
+}
+
+// Passa um bloco de amostras de 12 bits pelo filtro e retorna a saída atual.
+// Custo por amostra: uma soma; o resto roda uma vez a cada 2^decimacao.
+uint16_t filtro_processar(filtro_t *filtro, const uint16_t *amostras, size_t n)
+{
+    uint16_t por_saida = 1u << filtro->cfg.decimacao;
+    for (size_t i = 0; i < n; ++i)
+    {
+        filtro->soma += amostras[i];
+        if (++filtro->acumuladas < por_saida)
+            continue;
+
+        // Média com FILTRO_FRACAO bits de fração, arredondada
+        int32_t media;
+        if (filtro->cfg.decimacao <= FILTRO_FRACAO)
+            media = filtro->soma << (FILTRO_FRACAO - filtro->cfg.decimacao);
+        else
+            media = (filtro->soma + (1u << (filtro->cfg.decimacao - FILTRO_FRACAO - 1))) >> (filtro->cfg.decimacao - FILTRO_FRACAO);
+        filtro->soma = 0;
+        filtro->acumuladas = 0;
+
+        filtro_saida(filtro, media);
+    }
+    return filtro_valor(filtro);
+}
+
+// Saída atual em 12 bits (0 a 4095)
+uint16_t filtro_valor(const filtro_t *filtro)
+{
+    int32_t v = (filtro->saida + (1 << (FILTRO_FRACAO - 1))) >> FILTRO_FRACAO;
+    return v < 0 ? 0 : v > 4095 ? 4095 : v;
+}
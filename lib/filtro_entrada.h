@@ -0,0 +1,67 @@
+#ifndef FILTRO_ENTRADA_H
+#define FILTRO_ENTRADA_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Estágio de filtro para entradas analógicas (ADC de 12 bits), aplicado a
+// blocos de amostras em ordem:
+//
+//   1. sobreamostragem: média de 2^decimacao amostras por saída, guardando
+//      4 bits de fração (o ruído médio cai e sobra resolução)
+//   2. suavização: passa-baixa de um polo em ponto fixo, y += (x - y) / 2^k,
+//      ou mediana das últimas N saídas (bom contra picos isolados)
+//   3. zona morta em volta do centro medido: o trecho é descontado e o resto
+//      da faixa esticado, então a saída é contínua ao sair dela e ainda
+//      alcança 0 e 4095
+//   4. histerese (folga): a saída só anda quando a entrada se afasta mais que
+//      'histerese' dela, e aí acompanha a entrada sem degraus; com a entrada
+//      esticada no trilho a saída vai direto para 0 ou 4095
+//
+// Os limites de zona morta e histerese são em contagens de 12 bits.
+#define FILTRO_FRACAO 4 // Bits de fração interna
+#define FILTRO_CENTRO_DESVIO_MAX 1024 // Calibração mais longe de 2048 é descartada
+#define FILTRO_FATOR_BITS 14 // Fração dos fatores de esticamento
+#define FILTRO_MEDIANA_MAX 7
+
+typedef enum
+{
+    FILTRO_NENHUM,
+    FILTRO_IIR,
+    FILTRO_MEDIANA,
+} filtro_tipo_t;
+
+typedef struct
+{
+    uint8_t decimacao;  // log2 das amostras por saída (0 = sem sobreamostragem)
+    filtro_tipo_t tipo;
+    uint8_t iir_shift;  // IIR: alfa = 1 / 2^iir_shift
+    uint8_t mediana_n;  // Mediana: janela ímpar de até FILTRO_MEDIANA_MAX
+    uint16_t zona_morta;
+    uint16_t histerese;
+} filtro_config_t;
+
+typedef struct
+{
+    filtro_config_t cfg;
+    uint32_t soma;       // Sobreamostragem em andamento
+    uint16_t acumuladas;
+    int32_t iir;         // Estado do IIR com 8 bits extras de fração
+    uint16_t janela[FILTRO_MEDIANA_MAX];
+    uint8_t janela_pos;
+    uint8_t janela_cheia;
+    int32_t centro;      // Com FILTRO_FRACAO bits de fração
+    int32_t saida;       // Idem
+    int32_t zona;        // Zona morta efetiva, idem
+    uint16_t fator_acima; // Esticamento fora da zona morta, em 2.14 (até 2.0)
+    uint16_t fator_abaixo;
+    bool iniciado;
+} filtro_t;
+
+void filtro_iniciar(filtro_t *filtro, const filtro_config_t *cfg);
+bool filtro_calibrar_centro(filtro_t *filtro, const uint16_t *amostras, size_t n);
+uint16_t filtro_processar(filtro_t *filtro, const uint16_t *amostras, size_t n);
+uint16_t filtro_valor(const filtro_t *filtro);
+
+#endif // FILTRO_ENTRADA_H
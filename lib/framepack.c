@@ -0,0 +1,91 @@
+#include "framepack.h"
+
+// Quando o pack tem a largura da matriz, a posição linear do pixel já indexa
+// np_mapa direto; caso contrário o pack é desenhado no canto superior
+// esquerdo e o que não cabe na matriz é descartado.
+static inline void fp_escrever_pixel(npLED_t *destino, const frame_pack_t *pack, uint16_t pixel, npColor_t cor)
+{
+    int index;
+    if (pack->largura == MATRIZ_LARGURA)
+    {
+        if (pixel >= LED_COUNT)
+            return;
+        index = np_mapa[pixel];
+    }
+    else
+    {
+        uint16_t x = pixel % pack->largura, y = pixel / pack->largura;
+        if (x >= MATRIZ_LARGURA || y >= MATRIZ_ALTURA)
+            return;
+        index = getIndex(x, y);
+    }
+    if (destino == leds)
+    {
+        npSetLED(index, cor.r, cor.g, cor.b); // Mantém a estimativa de corrente em dia
+        return;
+    }
+    destino[index].R = cor.r;
+    destino[index].G = cor.g;
+    destino[index].B = cor.b;
+}
+
+// Decodifica um quadro direto no buffer de LEDs (normalmente 'leds').
+// Quadros delta só alteram os pixels listados, então destino deve conter o
+// quadro anterior da sequência.
+void fp_decodificar_quadro(const frame_pack_t *pack, uint8_t quadro, npLED_t *destino)
+{
+    if (quadro >= pack->num_quadros)
+        return;
+
+    const fp_quadro_t *q = &pack->quadros[quadro];
+    uint16_t num_pixels = pack->largura * pack->altura;
+
+    switch (q->tipo)
+    {
+    case FP_QUADRO_PALETA:
+    {
+        uint8_t bpp = pack->bits_por_pixel;
+        uint8_t mascara = (1u << bpp) - 1;
+        uint32_t bit = 0;
+        for (uint16_t p = 0; p < num_pixels; ++p, bit += bpp)
+        {
+            uint8_t cor = (q->dados[bit >> 3] >> (bit & 7)) & mascara;
+            fp_escrever_pixel(destino, pack, p, pack->paleta[cor < pack->num_cores ? cor : 0]);
+        }
+        break;
+    }
+
+    case FP_QUADRO_RGB:
+        for (uint16_t p = 0; p < num_pixels; ++p)
+        {
+            const uint8_t *rgb = &q->dados[p * 3];
+            fp_escrever_pixel(destino, pack, p, (npColor_t){rgb[0], rgb[1], rgb[2]});
+        }
+        break;
+
+    case FP_QUADRO_DELTA:
+        for (uint16_t i = 0; i < q->tamanho; ++i)
+        {
+            const uint8_t *entrada = &q->dados[i * 3];
+            uint16_t p = entrada[0] | (entrada[1] << 8);
+            uint8_t cor = entrada[2];
+            if (p < num_pixels)
+                fp_escrever_pixel(destino, pack, p, pack->paleta[cor < pack->num_cores ? cor : 0]);
+        }
+        break;
+
+    case FP_QUADRO_RLE:
+    {
+        uint16_t p = 0;
+        for (uint16_t i = 0; i < q->tamanho && p < num_pixels; ++i)
+        {
+            uint8_t quantidade = q->dados[i * 2];
+            uint8_t cor = q->dados[i * 2 + 1];
+            npColor_t c = pack->paleta[cor < pack->num_cores ? cor : 0];
+            for (; quantidade && p < num_pixels; --quantidade, ++p)
+                fp_escrever_pixel(destino, pack, p, c);
+        }
+        break;
+    }
+    }
+}
@@ -0,0 +1,39 @@
+#ifndef FRAMEPACK_H
+#define FRAMEPACK_H
+
+#include <stdint.h>
+#include "matrizRGB.h"
+
+// Pacote de quadros para a matriz de LEDs, pensado para ficar na flash (const).
+// Os pixels de cada quadro seguem a ordem lógica: linha a linha, a partir do
+// canto superior esquerdo; o decodificador faz o mapeamento físico via np_mapa.
+
+typedef enum
+{
+    FP_QUADRO_PALETA = 0, // Todos os pixels, índices de paleta com bits_por_pixel bits (LSB primeiro)
+    FP_QUADRO_RGB = 1,    // Todos os pixels, 3 bytes R, G, B
+    FP_QUADRO_DELTA = 2,  // 'tamanho' trios (pixel LSB, pixel MSB, índice de paleta) aplicados sobre o quadro anterior
+    FP_QUADRO_RLE = 3,    // 'tamanho' pares (quantidade 1-255, índice de paleta) cobrindo o quadro em ordem
+} fp_tipo_quadro_t;
+
+typedef struct
+{
+    uint16_t duracao_ms; // Tempo de exibição do quadro
+    uint8_t tipo;        // fp_tipo_quadro_t
+    uint16_t tamanho;    // FP_QUADRO_DELTA: número de trios; FP_QUADRO_RLE: número de pares
+    const uint8_t *dados;
+} fp_quadro_t;
+
+typedef struct frame_pack
+{
+    uint8_t largura, altura;
+    uint8_t num_quadros;
+    uint8_t bits_por_pixel; // 1, 2, 4 ou 8
+    uint8_t num_cores;
+    const npColor_t *paleta;
+    const fp_quadro_t *quadros;
+} frame_pack_t;
+
+void fp_decodificar_quadro(const frame_pack_t *pack, uint8_t quadro, npLED_t *destino);
+
+#endif // FRAMEPACK_H
@@ -1,6 +1,10 @@
 #include "leds.h"
 #include "hardware/pwm.h"
+#include "hardware/irq.h"
+#include "hardware/clocks.h"
+#include "hardware/sync.h"
 #include "matrizRGB.h"
+#include "cor.h"
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -10,6 +14,199 @@ static uint slice_num_red;
 static uint slice_num_green;
 static uint slice_num_blue;
 
+// Motor de efeitos: o contador de um slice PWM sem pinos gera a interrupção
+// de wrap a LED_EFEITO_HZ. A cada tique os níveis (8.16, com 256.0 = aceso)
+// andam um passo em ponto fixo e passam pelo gamma de 12 bits interpolado,
+// usando toda a faixa do wrap 4095. Sem efeito ativo a interrupção fica
+// desligada, então não há custo entre um efeito e outro.
+enum
+{
+    LED_EFEITO_NENHUM,
+    LED_EFEITO_RAMPA,
+    LED_EFEITO_RESPIRAR,
+    LED_EFEITO_CICLO_HSV,
+};
+
+#define LED_NIVEL(c) ((uint32_t)(c) * 65793u) // 0..255 para 8.16 (255 = quase 256.0)
+
+static volatile uint8_t led_efeito = LED_EFEITO_NENHUM;
+static uint32_t led_nivel[3];      // R, G, B atuais
+static int32_t led_passo[3];       // Passo por tique da rampa
+static uint32_t led_destino[3];
+static uint32_t led_tiques;        // Tiques restantes da rampa
+static uint32_t led_fase;          // Efeitos periódicos: uma volta = 2^32
+static uint32_t led_passo_fase;
+static npColor_t led_cor_efeito;   // Cor da respiração
+static uint8_t led_saturacao, led_valor;
+
+// Gamma 2.2 em 12 bits com 257 pontos (interpolado): round(4095 * (i / 256)^2.2)
+static const uint16_t led_gamma12[257] = {
+       0,    0,    0,    0,    0,    1,    1,    1,    2,    3,    3,    4,    5,    6,    7,    8,
+       9,   10,   12,   13,   15,   17,   19,   20,   22,   25,   27,   29,   31,   34,   37,   39,
+      42,   45,   48,   51,   55,   58,   62,   65,   69,   73,   77,   81,   85,   89,   94,   98,
+     103,  108,  113,  118,  123,  128,  133,  139,  145,  150,  156,  162,  168,  175,  181,  187,
+     194,  201,  208,  215,  222,  229,  236,  244,  251,  259,  267,  275,  283,  291,  300,  308,
+     317,  326,  335,  344,  353,  362,  372,  381,  391,  401,  411,  421,  431,  441,  452,  463,
+     473,  484,  495,  506,  518,  529,  541,  553,  564,  576,  589,  601,  613,  626,  639,  651,
+     664,  677,  691,  704,  718,  731,  745,  759,  773,  788,  802,  816,  831,  846,  861,  876,
+     891,  907,  922,  938,  954,  970,  986, 1002, 1018, 1035, 1052, 1068, 1085, 1103, 1120, 1137,
+    1155, 1173, 1190, 1208, 1227, 1245, 1263, 1282, 1301, 1320, 1339, 1358, 1377, 1397, 1416, 1436,
+    1456, 1476, 1496, 1517, 1537, 1558, 1579, 1600, 1621, 1642, 1664, 1685, 1707, 1729, 1751, 1773,
+    1796, 1818, 1841, 1864, 1887, 1910, 1933, 1957, 1980, 2004, 2028, 2052, 2076, 2101, 2125, 2150,
+    2175, 2200, 2225, 2250, 2276, 2301, 2327, 2353, 2379, 2405, 2432, 2458, 2485, 2512, 2539, 2566,
+    2593, 2621, 2649, 2676, 2704, 2733, 2761, 2789, 2818, 2847, 2876, 2905, 2934, 2963, 2993, 3023,
+    3053, 3083, 3113, 3143, 3174, 3205, 3235, 3266, 3298, 3329, 3360, 3392, 3424, 3456, 3488, 3520,
+    3553, 3586, 3618, 3651, 3685, 3718, 3751, 3785, 3819, 3853, 3887, 3921, 3956, 3990, 4025, 4060,
+    4095,
+};
+
+// Gamma de 12 bits de um nível 8.16, interpolando entre os 257 pontos
+static inline uint16_t led_gamma(uint32_t nivel)
+{
+    uint32_t v = nivel >> 8;
+    uint32_t i = v >> 8, frac = v & 0xFF;
+    if (i >= 256)
+        return 4095;
+    return led_gamma12[i] + (((led_gamma12[i + 1] - led_gamma12[i]) * frac) >> 8);
+}
+
+// Nível de 12 bits na escala do wrap atual do slice. O verde divide o slice
+// com o buzzer 1, que troca o wrap a cada nota (ver buzzer.h): reescalar
+// mantém o duty sem mexer no tom, e com o wrap de repouso a conta é a
+// identidade.
+static void led_escrever(uint pin, uint32_t nivel12)
+{
+    uint32_t topo = pwm_hw->slice[pwm_gpio_to_slice_num(pin)].top + 1u;
+    pwm_set_gpio_level(pin, topo == 4096 ? nivel12 : (nivel12 * topo + 2048) >> 12);
+}
+
+static void led_aplicar_niveis(void)
+{
+    // O alarme do buzzer não pode trocar o wrap entre a leitura e a escrita
+    uint32_t estado = save_and_disable_interrupts();
+    led_escrever(LED_RED_PIN, led_gamma(led_nivel[0]));
+    led_escrever(LED_GREEN_PIN, led_gamma(led_nivel[1]));
+    led_escrever(LED_BLUE_PIN, led_gamma(led_nivel[2]));
+    restore_interrupts(estado);
+}
+
+// Matiz com uma volta = 2^32 para níveis 8.16, pela conversão de 16 bits de
+// cor.h, então o ciclo não anda em degraus visíveis
+static void led_hsv(uint32_t matiz, uint8_t s, uint8_t v, uint32_t nivel[3])
+{
+    uint16_t rgb[3];
+    cor_hsv_para_rgb16(((uint64_t)matiz * 6) >> 16, s, v, rgb);
+    for (uint c = 0; c < 3; ++c)
+        nivel[c] = ((uint32_t)rgb[c] << 8) | (rgb[c] >> 8);
+}
+
+static void led_tique(void)
+{
+    if (!(pwm_get_irq_status_mask() & (1u << LED_EFEITO_SLICE)))
+        return;
+    pwm_clear_irq(LED_EFEITO_SLICE);
+
+    switch (led_efeito)
+    {
+    case LED_EFEITO_RAMPA:
+        if (--led_tiques == 0)
+        {
+            for (uint c = 0; c < 3; ++c)
+                led_nivel[c] = led_destino[c];
+            led_efeito_parar(); // Chegou ao destino: desliga a interrupção
+        }
+        else
+        {
+            for (uint c = 0; c < 3; ++c)
+                led_nivel[c] += led_passo[c];
+        }
+        break;
+
+    case LED_EFEITO_RESPIRAR:
+    {
+        // Triângulo no espaço perceptivo: com o gamma parece uma respiração
+        led_fase += led_passo_fase;
+        uint32_t f = led_fase >> 16;
+        uint32_t onda = f < 32768 ? f * 2 : (65535 - f) * 2;
+        led_nivel[0] = (led_cor_efeito.r * onda * 257u) >> 8;
+        led_nivel[1] = (led_cor_efeito.g * onda * 257u) >> 8;
+        led_nivel[2] = (led_cor_efeito.b * onda * 257u) >> 8;
+        break;
+    }
+
+    case LED_EFEITO_CICLO_HSV:
+        led_fase += led_passo_fase;
+        led_hsv(led_fase, led_saturacao, led_valor, led_nivel);
+        break;
+
+    default:
+        return;
+    }
+    led_aplicar_niveis();
+}
+
+// Troca o efeito com a interrupção do slice desligada, para o tique nunca ver
+// um estado pela metade
+static void led_efeito_iniciar(uint8_t efeito)
+{
+    led_efeito = efeito;
+    pwm_clear_irq(LED_EFEITO_SLICE);
+    pwm_set_irq_enabled(LED_EFEITO_SLICE, true);
+}
+
+void led_efeito_parar(void)
+{
+    pwm_set_irq_enabled(LED_EFEITO_SLICE, false);
+    led_efeito = LED_EFEITO_NENHUM;
+}
+
+bool led_efeito_ativo(void)
+{
+    return led_efeito != LED_EFEITO_NENHUM;
+}
+
+// Leva cada canal do nível atual até 'cor' em 'duracao_ms', com gamma
+void led_rampa(npColor_t cor, uint32_t duracao_ms)
+{
+    led_efeito_parar();
+    led_destino[0] = LED_NIVEL(cor.r);
+    led_destino[1] = LED_NIVEL(cor.g);
+    led_destino[2] = LED_NIVEL(cor.b);
+
+    led_tiques = duracao_ms * LED_EFEITO_HZ / 1000;
+    if (led_tiques == 0)
+    {
+        for (uint c = 0; c < 3; ++c)
+            led_nivel[c] = led_destino[c];
+        led_aplicar_niveis();
+        return;
+    }
+    for (uint c = 0; c < 3; ++c)
+        led_passo[c] = ((int32_t)led_destino[c] - (int32_t)led_nivel[c]) / (int32_t)led_tiques;
+    led_efeito_iniciar(LED_EFEITO_RAMPA);
+}
+
+// Acende e apaga 'cor' continuamente, uma respiração a cada 'periodo_ms'
+void led_respirar(npColor_t cor, uint32_t periodo_ms)
+{
+    led_efeito_parar();
+    led_cor_efeito = cor;
+    led_fase = 0;
+    led_passo_fase = periodo_ms ? UINT32_MAX / (periodo_ms * LED_EFEITO_HZ / 1000 + 1) : 0;
+    led_efeito_iniciar(LED_EFEITO_RESPIRAR);
+}
+
+// Percorre o círculo de matizes uma vez a cada 'periodo_ms'
+void led_ciclo_hsv(uint8_t saturacao, uint8_t valor, uint32_t periodo_ms)
+{
+    led_efeito_parar();
+    led_saturacao = saturacao;
+    led_valor = valor;
+    led_fase = 0;
+    led_passo_fase = periodo_ms ? UINT32_MAX / (periodo_ms * LED_EFEITO_HZ / 1000 + 1) : 0;
+    led_efeito_iniciar(LED_EFEITO_CICLO_HSV);
+}
+
 void led_init(void)
 {
     // Configurar os pinos como PWM
@@ -34,6 +231,14 @@ void led_init(void)
     
     // Garantir que os LEDs comecem desligados
     turn_off_leds();
+
+    // Base de tempo dos efeitos: contador a 1 MHz, wrap a cada 1/LED_EFEITO_HZ
+    pwm_config tique = pwm_get_default_config();
+    pwm_config_set_clkdiv_int(&tique, clock_get_hz(clk_sys) / 1000000);
+    pwm_config_set_wrap(&tique, 1000000 / LED_EFEITO_HZ - 1);
+    pwm_init(LED_EFEITO_SLICE, &tique, true);
+    irq_add_shared_handler(PWM_IRQ_WRAP, led_tique, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    irq_set_enabled(PWM_IRQ_WRAP, true);
 }
 
 void força_leds(float dutycicle)
@@ -41,27 +246,24 @@ void força_leds(float dutycicle)
     // Limitar o duty cycle entre 0 e 100%
     if (dutycicle < 0.0f) dutycicle = 0.0f;
     if (dutycicle > 100.0f) dutycicle = 100.0f;
-    
-    // Converter de porcentagem (0-100) para o valor do contador PWM (0-4095)
-    uint16_t valor_pwm = (uint16_t)((dutycicle / 100.0f) * 4095);
-    
-    // Aplicar o mesmo duty cycle para todos os LEDs
-    pwm_set_gpio_level(LED_RED_PIN, valor_pwm);
-    pwm_set_gpio_level(LED_GREEN_PIN, valor_pwm);
-    pwm_set_gpio_level(LED_BLUE_PIN, valor_pwm);
+
+    // Ajuste imediato: interrompe qualquer efeito em andamento. A porcentagem
+    // é de brilho percebido e passa pelo mesmo gamma dos efeitos.
+    led_efeito_parar();
+    led_nivel[0] = led_nivel[1] = led_nivel[2] = LED_NIVEL(dutycicle * 255 / 100);
+    led_aplicar_niveis();
 }
 
 void acender_led_rgb(uint8_t r, uint8_t g, uint8_t b)
 {
-    // Converter os valores de 8 bits (0-255) para valores do contador PWM (0-4095)
-    uint16_t valor_r = (uint16_t)(r * 4095 / 255);
-    uint16_t valor_g = (uint16_t)(g * 4095 / 255);
-    uint16_t valor_b = (uint16_t)(b * 4095 / 255);
-    
-    // Configurar o nível PWM para cada cor
-    pwm_set_gpio_level(LED_RED_PIN, valor_r);
-    pwm_set_gpio_level(LED_GREEN_PIN, valor_g);
-    pwm_set_gpio_level(LED_BLUE_PIN, valor_b);
+    // Ajuste imediato: interrompe qualquer efeito em andamento. Os níveis vão
+    // pelo gamma, como nos efeitos, então as rampas seguintes partem
+    // exatamente da cor vista.
+    led_efeito_parar();
+    led_nivel[0] = LED_NIVEL(r);
+    led_nivel[1] = LED_NIVEL(g);
+    led_nivel[2] = LED_NIVEL(b);
+    led_aplicar_niveis();
 }
 
 void acender_led_rgb_cor(npColor_t cor)
@@ -72,14 +274,14 @@ void acender_led_rgb_cor(npColor_t cor)
 
 void acender_led_rgb_cor_aleatoria(void)
 {
-    acender_led_rgb_cor((npColor_t){rand() % 256, rand() % 256, rand() % 256});
+    acender_led_rgb_cor(cor_aleatoria());
 }
 
 
 void turn_off_leds(void)
 {
     // Desligar todos os LEDs configurando o nível PWM para 0
-    pwm_set_gpio_level(LED_RED_PIN, 0);
-    pwm_set_gpio_level(LED_GREEN_PIN, 0);
-    pwm_set_gpio_level(LED_BLUE_PIN, 0);
-}
\ No newline at end of file
+    led_efeito_parar();
+    led_nivel[0] = led_nivel[1] = led_nivel[2] = 0;
+    led_aplicar_niveis();
+}
@@ -9,6 +9,11 @@
 #define LED_BLUE_PIN 12
 #define LED_RED_PIN 13
 
+// Base de tempo do motor de efeitos: um slice PWM sem pinos em modo PWM (os
+// pinos 14/15 do slice 7 são do I2C), usado só pela interrupção de wrap
+#define LED_EFEITO_SLICE 7
+#define LED_EFEITO_HZ 1000
+
 // Inicialização dos LEDs
 void led_init(void);
 void força_leds(float dutycicle);
@@ -17,4 +22,11 @@ void turn_off_leds(void);
 void acender_led_rgb_cor(npColor_t cor);
 void acender_led_rgb_cor_aleatoria(void);
 
+// Efeitos com gamma e ponto fixo, executados na interrupção de wrap do PWM
+void led_rampa(npColor_t cor, uint32_t duracao_ms);
+void led_respirar(npColor_t cor, uint32_t periodo_ms);
+void led_ciclo_hsv(uint8_t saturacao, uint8_t valor, uint32_t periodo_ms);
+void led_efeito_parar(void);
+bool led_efeito_ativo(void);
+
 #endif // LED_CONTROL_H
\ No newline at end of file
@@ -0,0 +1,192 @@
+#include "matrizParalela.h"
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "ws2812_paralelo.pio.h"
+#include <string.h>
+
+// Cada palavra do FIFO leva 4 planos (4 bits de cor em todas as faixas), 5 us.
+// Depois do DMA ainda saem o FIFO unido (8 palavras) e o OSR.
+#define NP_PARALELO_US_POR_PALAVRA 5
+#define NP_PARALELO_PALAVRAS_PENDENTES 9
+#define NP_PARALELO_RESET_US 300
+
+// Pixels convertidos por vez antes da transposição
+#define NP_PARALELO_BLOCO 16
+
+static PIO np_par_pio;
+static uint np_par_sm;
+static int np_par_dma;
+static uint8_t np_par_faixas;
+static volatile bool np_par_ocupado = false;
+static uint32_t np_par_tempo_transposicao_us;
+
+// Planos de bits: 24 bytes (6 palavras) por LED, lidos pelo DMA em palavras
+static uint32_t np_par_buffer[NP_PARALELO_MAX_LEDS * 6];
+static uint32_t np_par_cores[NP_PARALELO_MAX_FAIXAS][NP_PARALELO_BLOCO];
+
+// Transpõe um byte de cor de 8 faixas (byte j = faixa j) em 8 planos, do bit
+// mais significativo para o menos: planos[k] tem no bit j o bit 7-k da faixa j.
+// Transposição 8x8 em duas palavras de 32 bits (trocas de 1, 2 e 4 bits).
+static inline void np_transpor_byte(uint32_t lo, uint32_t hi, uint8_t *planos)
+{
+    uint32_t t;
+    t = (lo ^ (lo >> 7)) & 0x00AA00AA;
+    lo ^= t ^ (t << 7);
+    t = (hi ^ (hi >> 7)) & 0x00AA00AA;
+    hi ^= t ^ (t << 7);
+    t = (lo ^ (lo >> 14)) & 0x0000CCCC;
+    lo ^= t ^ (t << 14);
+    t = (hi ^ (hi >> 14)) & 0x0000CCCC;
+    hi ^= t ^ (t << 14);
+    t = (lo ^ ((lo >> 28) | (hi << 4))) & 0xF0F0F0F0;
+    lo ^= t;
+    hi ^= t >> 4;
+
+    // Byte r do resultado é o plano do bit r
+    planos[0] = hi >> 24;
+    planos[1] = hi >> 16;
+    planos[2] = hi >> 8;
+    planos[3] = hi;
+    planos[4] = lo >> 24;
+    planos[5] = lo >> 16;
+    planos[6] = lo >> 8;
+    planos[7] = lo;
+}
+
+// Um LED de cada faixa (palavras GRB nos 24 bits mais altos) vira 24 planos,
+// na ordem em que saem no fio: G7..G0, R7..R0, B7..B0
+void npTransporFaixas(const uint32_t grb[NP_PARALELO_MAX_FAIXAS], uint8_t planos[24])
+{
+    for (uint byte = 0; byte < 3; ++byte)
+    {
+        uint shift = 24 - 8 * byte;
+        uint32_t lo = ((grb[0] >> shift) & 0xFF) | ((grb[1] >> shift) & 0xFF) << 8 |
+                      ((grb[2] >> shift) & 0xFF) << 16 | ((grb[3] >> shift) & 0xFF) << 24;
+        uint32_t hi = ((grb[4] >> shift) & 0xFF) | ((grb[5] >> shift) & 0xFF) << 8 |
+                      ((grb[6] >> shift) & 0xFF) << 16 | ((grb[7] >> shift) & 0xFF) << 24;
+        np_transpor_byte(lo, hi, &planos[8 * byte]);
+    }
+}
+
+static int64_t np_par_fim_latch(alarm_id_t id, void *user_data)
+{
+    np_par_ocupado = false;
+    return 0;
+}
+
+static void np_par_dma_irq_handler(void)
+{
+    if (!dma_channel_get_irq1_status(np_par_dma))
+        return;
+    dma_channel_acknowledge_irq1(np_par_dma);
+
+    uint32_t espera = NP_PARALELO_PALAVRAS_PENDENTES * NP_PARALELO_US_POR_PALAVRA + NP_PARALELO_RESET_US;
+    if (add_alarm_in_us(espera, np_par_fim_latch, NULL, true) < 0)
+    {
+        busy_wait_us(espera);
+        np_par_fim_latch(0, NULL);
+    }
+}
+
+// Faixas nos pinos pino_base .. pino_base + num_faixas - 1
+void npParaleloInit(uint8_t pino_base, uint8_t num_faixas)
+{
+    np_par_faixas = num_faixas > NP_PARALELO_MAX_FAIXAS ? NP_PARALELO_MAX_FAIXAS : num_faixas;
+
+    np_par_pio = pio0;
+    int sm_livre = pio_claim_unused_sm(np_par_pio, false);
+    if (sm_livre < 0)
+    {
+        np_par_pio = pio1;
+        sm_livre = pio_claim_unused_sm(np_par_pio, true);
+    }
+    np_par_sm = sm_livre;
+    uint offset = pio_add_program(np_par_pio, &ws2812_paralelo_program);
+    ws2812_paralelo_program_init(np_par_pio, np_par_sm, offset, pino_base, np_par_faixas, 800000.f);
+
+    np_par_dma = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(np_par_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(np_par_pio, np_par_sm, true));
+    dma_channel_configure(np_par_dma, &c, &np_par_pio->txf[np_par_sm], np_par_buffer, 0, false);
+
+    irq_add_shared_handler(DMA_IRQ_1, np_par_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    dma_channel_set_irq1_enabled(np_par_dma, true);
+    irq_set_enabled(DMA_IRQ_1, true);
+}
+
+// Envia um quadro para todas as faixas de uma vez. faixas[i] pode ser NULL
+// (faixa apagada); faixas mais curtas que a maior recebem preto no fim, que
+// passa adiante do último LED sem efeito. O estágio de cor (gamma, escala,
+// brilho) é o mesmo da matriz principal.
+void npParaleloWrite(const npLED_t *const faixas[], const uint16_t tamanhos[])
+{
+    npParaleloAguardar();
+
+    uint16_t num_leds = 0;
+    for (uint f = 0; f < np_par_faixas; ++f)
+    {
+        if (faixas[f] && tamanhos[f] > num_leds)
+            num_leds = tamanhos[f];
+    }
+    if (num_leds > NP_PARALELO_MAX_LEDS)
+        num_leds = NP_PARALELO_MAX_LEDS;
+    if (num_leds == 0)
+        return;
+
+    uint8_t *planos = (uint8_t *)np_par_buffer;
+    uint32_t grb[NP_PARALELO_MAX_FAIXAS];
+    uint32_t tempo_transposicao = 0;
+
+    for (uint base = 0; base < num_leds; base += NP_PARALELO_BLOCO)
+    {
+        uint n = num_leds - base < NP_PARALELO_BLOCO ? num_leds - base : NP_PARALELO_BLOCO;
+
+        for (uint f = 0; f < NP_PARALELO_MAX_FAIXAS; ++f)
+        {
+            uint validos = 0;
+            if (f < np_par_faixas && faixas[f] && tamanhos[f] > base)
+            {
+                validos = tamanhos[f] - base < n ? tamanhos[f] - base : n;
+                npConverterCores(&faixas[f][base], np_par_cores[f], validos);
+            }
+            memset(&np_par_cores[f][validos], 0, (n - validos) * sizeof(uint32_t));
+        }
+
+        uint32_t inicio = time_us_32();
+        for (uint i = 0; i < n; ++i)
+        {
+            for (uint f = 0; f < NP_PARALELO_MAX_FAIXAS; ++f)
+                grb[f] = np_par_cores[f][i];
+            npTransporFaixas(grb, &planos[(base + i) * 24]);
+        }
+        tempo_transposicao += time_us_32() - inicio;
+    }
+    np_par_tempo_transposicao_us = tempo_transposicao;
+
+    np_par_ocupado = true;
+    dma_channel_transfer_from_buffer_now(np_par_dma, np_par_buffer, num_leds * 6);
+}
+
+bool npParaleloOcupado(void)
+{
+    return np_par_ocupado;
+}
+
+void npParaleloAguardar(void)
+{
+    while (np_par_ocupado)
+        tight_loop_contents();
+}
+
+// Tempo gasto só na transposição no último npParaleloWrite, para comparar
+// com o tempo de transmissão (30 us por LED da faixa mais longa)
+uint32_t npParaleloTempoTransposicao(void)
+{
+    return np_par_tempo_transposicao_us;
+}
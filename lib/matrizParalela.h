@@ -0,0 +1,24 @@
+#ifndef MATRIZPARALELA_H
+#define MATRIZPARALELA_H
+#include <stdint.h>
+#include <stdbool.h>
+#include "matrizRGB.h"
+
+// Saída WS2812 em paralelo: até 8 faixas em pinos consecutivos, alimentadas
+// por uma única máquina PIO e um único DMA. Os pixels das faixas são
+// transpostos em planos de bits (um byte por bit de cor, um bit por faixa),
+// então o tempo de um quadro é o da faixa mais longa, não a soma das faixas.
+
+#define NP_PARALELO_MAX_FAIXAS 8
+#ifndef NP_PARALELO_MAX_LEDS
+#define NP_PARALELO_MAX_LEDS 256 // LEDs por faixa
+#endif
+
+void npParaleloInit(uint8_t pino_base, uint8_t num_faixas);
+void npParaleloWrite(const npLED_t *const faixas[], const uint16_t tamanhos[]);
+bool npParaleloOcupado(void);
+void npParaleloAguardar(void);
+uint32_t npParaleloTempoTransposicao(void);
+void npTransporFaixas(const uint32_t grb[NP_PARALELO_MAX_FAIXAS], uint8_t planos[24]);
+
+#endif // MATRIZPARALELA_H
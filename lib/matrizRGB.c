@@ -1,113 +1,574 @@
 #include "matrizRGB.h"
+#include "framepack.h"
+#include "cor.h"
+#include "ciclos.h"
 #include "pico/stdlib.h"
 #include "hardware/pio.h"
 #include "hardware/clocks.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
 #include "ws2818b.pio.h"
+#include <string.h>
 
-#define LED_COUNT 25 // Número de Leds na matriz 5x5
+// Tempo para o FIFO de TX (8 palavras, FIFO unido) e o OSR esvaziarem depois
+// que o DMA termina: cada LED leva 24 bits * 1,25 us = 30 us.
+#define NP_US_POR_LED 30
+#define NP_PALAVRAS_PENDENTES (LED_COUNT < 9 ? LED_COUNT : 9)
+// Intervalo de reset/latch com a linha em nível baixo (WS2812B exige >= 280 us)
+#define NP_RESET_US 300
 
 // Buffer de pixels global
 npLED_t leds[LED_COUNT];
+
+// Repetição de macros para gerar a tabela de índices sem código de inicialização
+#define NP_REP1(f, n) f(n)
+#define NP_REP2(f, n) NP_REP1(f, n) NP_REP1(f, (n) + 1)
+#define NP_REP4(f, n) NP_REP2(f, n) NP_REP2(f, (n) + 2)
+#define NP_REP8(f, n) NP_REP4(f, n) NP_REP4(f, (n) + 4)
+#define NP_REP16(f, n) NP_REP8(f, n) NP_REP8(f, (n) + 8)
+#define NP_REP32(f, n) NP_REP16(f, n) NP_REP16(f, (n) + 16)
+#define NP_REP64(f, n) NP_REP32(f, n) NP_REP32(f, (n) + 32)
+#define NP_REP128(f, n) NP_REP64(f, n) NP_REP64(f, (n) + 64)
+#define NP_REP256(f, n) NP_REP128(f, n) NP_REP128(f, (n) + 128)
+#define NP_REP512(f, n) NP_REP256(f, n) NP_REP256(f, (n) + 256)
+#define NP_REP1024(f, n) NP_REP512(f, n) NP_REP512(f, (n) + 512)
+
+// Entradas além de LED_COUNT (a tabela tem o tamanho da próxima potência de
+// dois) nunca são consultadas e ficam em zero
+#define NP_MAPA_ENTRADA(i) ((i) < LED_COUNT ? MATRIZ_INDICE_LINEAR(i) : 0),
+
+#if LED_COUNT <= 16
+#define NP_MAPA_TAMANHO 16
+#elif LED_COUNT <= 32
+#define NP_MAPA_TAMANHO 32
+#elif LED_COUNT <= 64
+#define NP_MAPA_TAMANHO 64
+#elif LED_COUNT <= 128
+#define NP_MAPA_TAMANHO 128
+#elif LED_COUNT <= 256
+#define NP_MAPA_TAMANHO 256
+#elif LED_COUNT <= 512
+#define NP_MAPA_TAMANHO 512
+#else
+#define NP_MAPA_TAMANHO 1024
+#endif
+
+#define NP_CONCAT(a, b) a##b
+#define NP_REP(n) NP_CONCAT(NP_REP, n)
+
+const uint16_t np_mapa[NP_MAPA_TAMANHO] = {NP_REP(NP_MAPA_TAMANHO)(NP_MAPA_ENTRADA, 0)};
 static PIO np_pio;
 static uint sm;
 
+// Palavras GRB empacotadas (24 bits mais altos) lidas pelo DMA
+static uint32_t np_buffer[LED_COUNT];
+static uint32_t np_ciclos_conversao; // Ciclos do np_converter no último npWrite (SysTick)
+static int np_dma;
+static volatile bool np_ocupado = false;
+static void (*np_callback)(void) = NULL;
+
+// Estágio de cor aplicado só na saída (npWrite): o conteúdo de 'leds' nunca é
+// reescrito. saída = gamma[v] * escala_canal * brilho, tudo em ponto fixo.
+#define NP_ESCALA_UM 256 // 1.0 em ponto fixo 8.8
+static uint16_t np_escala[3] = {NP_ESCALA_UM, NP_ESCALA_UM, NP_ESCALA_UM}; // R, G, B
+static uint8_t np_brilho = 255;
+static bool np_gamma_ativo = true;
+
+// Estimativa de corrente: somas por canal dos valores brutos e após o gamma,
+// mantidas pelo npSetLED a cada pixel alterado. Como a escala e o brilho são
+// lineares, a corrente do quadro sai dessas somas em O(1) no npWrite.
+#ifndef NP_MA_POR_CANAL
+#define NP_MA_POR_CANAL 20 // Corrente de um canal em 255
+#endif
+#ifndef NP_MA_OCIOSO
+#define NP_MA_OCIOSO 1 // Consumo do controlador de cada LED, mesmo apagado
+#endif
+static int32_t np_soma_bruta[3]; // R, G, B
+static int32_t np_soma_gamma[3];
+static uint16_t np_limite_ma = 0; // 0: sem limite
+static uint16_t np_limite_fator = NP_ESCALA_UM; // Fator 8.8 aplicado pelo limitador no último quadro
+static uint32_t np_corrente_estimada_ma;
+static uint32_t np_corrente_limitada_ma;
+
+// Correção gamma 2.2: round(255 * (i / 255)^2.2)
+static const uint8_t np_gamma[256] = {
+      0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   0,   1,
+      1,   1,   1,   1,   1,   1,   1,   1,   1,   2,   2,   2,   2,   2,   2,   2,
+      3,   3,   3,   3,   3,   4,   4,   4,   4,   5,   5,   5,   5,   6,   6,   6,
+      6,   7,   7,   7,   8,   8,   8,   9,   9,   9,  10,  10,  11,  11,  11,  12,
+     12,  13,  13,  13,  14,  14,  15,  15,  16,  16,  17,  17,  18,  18,  19,  19,
+     20,  20,  21,  22,  22,  23,  23,  24,  25,  25,  26,  26,  27,  28,  28,  29,
+     30,  30,  31,  32,  33,  33,  34,  35,  35,  36,  37,  38,  39,  39,  40,  41,
+     42,  43,  43,  44,  45,  46,  47,  48,  49,  49,  50,  51,  52,  53,  54,  55,
+     56,  57,  58,  59,  60,  61,  62,  63,  64,  65,  66,  67,  68,  69,  70,  71,
+     73,  74,  75,  76,  77,  78,  79,  81,  82,  83,  84,  85,  87,  88,  89,  90,
+     91,  93,  94,  95,  97,  98,  99, 100, 102, 103, 105, 106, 107, 109, 110, 111,
+    113, 114, 116, 117, 119, 120, 121, 123, 124, 126, 127, 129, 130, 132, 133, 135,
+    137, 138, 140, 141, 143, 145, 146, 148, 149, 151, 153, 154, 156, 158, 159, 161,
+    163, 165, 166, 168, 170, 172, 173, 175, 177, 179, 181, 182, 184, 186, 188, 190,
+    192, 194, 196, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221,
+    223, 225, 227, 229, 231, 234, 236, 238, 240, 242, 244, 246, 248, 251, 253, 255,
+};
+
+// Modo de dithering temporal: a entrada é mantida em 16 bits por canal e a
+// saída de 16 bits (gamma, escala, brilho e limitador) é reduzida a 8 bits por
+// sigma-delta, com o erro de cada canal levado ao quadro seguinte. Os quadros
+// são reenviados continuamente a partir do fim do latch, em interrupção.
+static uint16_t np_leds16[LED_COUNT][3];      // Entrada em 16 bits (R, G, B)
+static uint16_t np_alvo16[2][LED_COUNT][3];   // Saída em 16 bits, dois buffers
+static volatile uint8_t np_alvo_atual = 0;    // Buffer lido pelo refresh
+static uint8_t np_erro[LED_COUNT][3];         // Resto de cada canal (8 bits de fração)
+static volatile bool np_dithering = false;
+static uint32_t np_dither_custo_us;
+static uint32_t np_dither_quadros;
+static uint32_t np_dither_fps;
+static uint32_t np_dither_janela_us;
+
+// Gamma 2.2 em 16 bits com 257 pontos (interpolado): round(65535 * (i / 256)^2.2)
+static const uint16_t np_gamma16[257] = {
+        0,     0,     2,     4,     7,    11,    17,    24,    32,    41,    52,    64,    78,    93,   110,   128,
+      147,   168,   191,   215,   240,   267,   296,   327,   359,   392,   428,   465,   504,   544,   586,   630,
+      676,   723,   772,   823,   875,   930,   986,  1044,  1104,  1165,  1229,  1294,  1361,  1430,  1501,  1574,
+     1648,  1725,  1803,  1884,  1966,  2050,  2136,  2224,  2314,  2406,  2500,  2595,  2693,  2793,  2895,  2998,
+     3104,  3212,  3322,  3433,  3547,  3663,  3781,  3900,  4022,  4146,  4272,  4400,  4530,  4663,  4797,  4933,
+     5072,  5212,  5355,  5499,  5646,  5795,  5946,  6099,  6255,  6412,  6572,  6733,  6897,  7063,  7231,  7402,
+     7574,  7749,  7926,  8105,  8286,  8469,  8655,  8843,  9033,  9225,  9419,  9616,  9815, 10016, 10219, 10425,
+    10632, 10842, 11054, 11269, 11486, 11705, 11926, 12149, 12375, 12603, 12833, 13066, 13301, 13538, 13777, 14019,
+    14263, 14509, 14758, 15009, 15262, 15517, 15775, 16035, 16298, 16563, 16830, 17099, 17371, 17645, 17922, 18201,
+    18482, 18765, 19051, 19339, 19630, 19923, 20218, 20516, 20816, 21119, 21424, 21731, 22040, 22352, 22667, 22984,
+    23303, 23624, 23949, 24275, 24604, 24935, 25269, 25605, 25943, 26284, 26628, 26973, 27322, 27672, 28026, 28381,
+    28739, 29100, 29462, 29828, 30196, 30566, 30939, 31314, 31692, 32072, 32454, 32840, 33227, 33617, 34010, 34405,
+    34802, 35202, 35605, 36010, 36417, 36827, 37240, 37655, 38072, 38493, 38915, 39340, 39768, 40198, 40631, 41066,
+    41503, 41944, 42387, 42832, 43280, 43730, 44183, 44639, 45097, 45557, 46020, 46486, 46954, 47425, 47899, 48374,
+    48853, 49334, 49818, 50304, 50793, 51284, 51778, 52275, 52774, 53276, 53780, 54287, 54796, 55308, 55823, 56341,
+    56860, 57383, 57908, 58436, 58966, 59499, 60035, 60573, 61114, 61657, 62203, 62752, 63303, 63857, 64414, 64973,
+    65535,
+};
 
 npColor_t colors[] = {COLOR_RED, COLOR_GREEN, COLOR_BLUE, COLOR_WHITE, COLOR_BLACK,
                              COLOR_YELLOW, COLOR_CYAN, COLOR_MAGENTA, COLOR_PURPLE, COLOR_ORANGE};
 
+static void np_refresh_dither(void);
+
+// Fim do intervalo de latch: o quadro foi aceito pelos LEDs. No modo de
+// dithering o próximo quadro sai daqui mesmo, sem passar pelo laço principal.
+static int64_t np_fim_latch(alarm_id_t id, void *user_data)
+{
+    np_ocupado = false;
+    if (np_callback)
+        np_callback();
+    if (np_dithering)
+        np_refresh_dither();
+    return 0;
+}
+
+// O DMA entregou a última palavra ao FIFO; falta o PIO transmiti-la e o reset
+static void np_dma_irq_handler(void)
+{
+    if (!dma_channel_get_irq1_status(np_dma))
+        return;
+    dma_channel_acknowledge_irq1(np_dma);
+
+    if (add_alarm_in_us(NP_PALAVRAS_PENDENTES * NP_US_POR_LED + NP_RESET_US, np_fim_latch, NULL, true) < 0)
+    {
+        // Sem alarmes livres: garante o intervalo aqui mesmo
+        busy_wait_us(NP_PALAVRAS_PENDENTES * NP_US_POR_LED + NP_RESET_US);
+        np_fim_latch(0, NULL);
+    }
+}
+
 // Inicialização da Matrix 5x5, na bitdoglab no pino 7
 void npInit(uint8_t pin)
 {
-    // Cria programa PIO.
-    uint offset = pio_add_program(pio0, &ws2818b_program);
+    // Toma posse de uma máquina PIO e carrega o programa no mesmo bloco.
     np_pio = pio0;
-
-    // Toma posse de uma máquina PIO.
-    sm = pio_claim_unused_sm(np_pio, false);
-    if (sm < 0)
+    int sm_livre = pio_claim_unused_sm(np_pio, false);
+    if (sm_livre < 0)
     {
         np_pio = pio1;
-        sm = pio_claim_unused_sm(np_pio, true);
+        sm_livre = pio_claim_unused_sm(np_pio, true);
     }
+    sm = sm_livre;
+    uint offset = pio_add_program(np_pio, &ws2818b_program);
 
     // Inicia programa na máquina PIO obtida.
     ws2818b_program_init(np_pio, sm, offset, pin, 800000.f);
 
+    // DMA alimenta o FIFO de TX no ritmo do DREQ da máquina de estados
+    np_dma = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(np_dma);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_32);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, pio_get_dreq(np_pio, sm, true));
+    dma_channel_configure(np_dma, &c, &np_pio->txf[sm], np_buffer, LED_COUNT, false);
+
+    irq_add_shared_handler(DMA_IRQ_1, np_dma_irq_handler, PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY);
+    dma_channel_set_irq1_enabled(np_dma, true);
+    irq_set_enabled(DMA_IRQ_1, true);
+
     // Limpa buffer de pixels.
     npClear();
 }
 
 // Função que seta, basicamente atribui uma cor a cada pino correspondente da matriz da placa
 
-void setMatrizDeLEDSComIntensidade(int matriz[5][5][3], double intensidadeR, double intensidadeG, double intensidadeB)
+// As intensidades viram a escala por canal do estágio de saída (convertidas uma
+// única vez para 8.8), e a matriz é copiada sem alteração para 'leds'.
+void setMatrizDeLEDSComIntensidade(int matriz[MATRIZ_ALTURA][MATRIZ_LARGURA][3], double intensidadeR, double intensidadeG, double intensidadeB)
 {
     // Validação das intensidades
     intensidadeR = (intensidadeR < 0.0 || intensidadeR > 1.0) ? 1.0 : intensidadeR;
     intensidadeG = (intensidadeG < 0.0 || intensidadeG > 1.0) ? 1.0 : intensidadeG;
     intensidadeB = (intensidadeB < 0.0 || intensidadeB > 1.0) ? 1.0 : intensidadeB;
 
+    npSetEscalaCanais((uint16_t)(intensidadeR * NP_ESCALA_UM),
+                      (uint16_t)(intensidadeG * NP_ESCALA_UM),
+                      (uint16_t)(intensidadeB * NP_ESCALA_UM));
+
     // Loop para configurar os LEDs
-    for (uint8_t linha = 0; linha < 5; linha++)
+    for (uint linha = 0; linha < MATRIZ_ALTURA; linha++)
     {
-        for (uint8_t coluna = 0; coluna < 5; coluna++)
+        for (uint coluna = 0; coluna < MATRIZ_LARGURA; coluna++)
         {
-            // Calcula os valores RGB ajustados pela intensidade
-            uint8_t r = (uint8_t)(float)(matriz[linha][coluna][0] * intensidadeR);
-            uint8_t g = (uint8_t)(float)(matriz[linha][coluna][1] * intensidadeG);
-            uint8_t b = (uint8_t)(float)(matriz[linha][coluna][2] * intensidadeB);
-
             uint index = getIndex(coluna, linha);
 
-            // Configura o LED diretamente
-            leds[index].R = r;
-            leds[index].G = g;
-            leds[index].B = b;
+            npSetLED(index, matriz[linha][coluna][0], matriz[linha][coluna][1], matriz[linha][coluna][2]);
         }
     }
 
     npWrite(); // Função para ligar os leds setados.
 }
 
-void npWrite()
+// Escala por canal em ponto fixo 8.8 (256 = 1.0, limitada a 1.0)
+void npSetEscalaCanais(uint16_t escala_r, uint16_t escala_g, uint16_t escala_b)
+{
+    np_escala[0] = escala_r > NP_ESCALA_UM ? NP_ESCALA_UM : escala_r;
+    np_escala[1] = escala_g > NP_ESCALA_UM ? NP_ESCALA_UM : escala_g;
+    np_escala[2] = escala_b > NP_ESCALA_UM ? NP_ESCALA_UM : escala_b;
+}
+
+// Registrador de brilho global (0-255), aplicado a todos os canais
+void npSetBrilho(uint8_t brilho)
+{
+    np_brilho = brilho;
+}
+
+uint8_t npGetBrilho(void)
 {
-    // Escreve cada dado de 8-bits dos pixels em sequência no buffer da máquina PIO.
+    return np_brilho;
+}
+
+void npSetGamma(bool ativo)
+{
+    np_gamma_ativo = ativo;
+}
+
+// Estágio de saída: converte n pixels em palavras GRB (24 bits mais altos,
+// MSB primeiro) com gamma, escala por canal e brilho. Usado também pelo
+// driver paralelo, para que todas as faixas tenham a mesma correção de cor.
+static void np_converter(const npLED_t *origem, uint32_t *destino, uint n, uint32_t limite)
+{
+    // Fator 8.8 de cada canal, combinando escala, brilho e limitador, calculado uma vez por chamada
+    uint32_t fator_r = (((np_escala[0] * (np_brilho + 1u)) >> 8) * limite) >> 8;
+    uint32_t fator_g = (((np_escala[1] * (np_brilho + 1u)) >> 8) * limite) >> 8;
+    uint32_t fator_b = (((np_escala[2] * (np_brilho + 1u)) >> 8) * limite) >> 8;
+
+    for (uint i = 0; i < n; ++i)
+    {
+        uint32_t r = origem[i].R, g = origem[i].G, b = origem[i].B;
+        if (np_gamma_ativo)
+        {
+            r = np_gamma[r];
+            g = np_gamma[g];
+            b = np_gamma[b];
+        }
+        r = (r * fator_r) >> 8;
+        g = (g * fator_g) >> 8;
+        b = (b * fator_b) >> 8;
+        destino[i] = (g << 24) | (r << 16) | (b << 8);
+    }
+}
+
+// Fora do npWrite o limitador não se aplica: a estimativa cobre só 'leds'
+void npConverterCores(const npLED_t *origem, uint32_t *destino, uint n)
+{
+    np_converter(origem, destino, n, NP_ESCALA_UM);
+}
+
+// Atualiza o pixel e as somas de corrente; custo O(1) por pixel alterado
+void npSetLED(uint index, uint8_t r, uint8_t g, uint8_t b)
+{
+    npLED_t *led = &leds[index];
+    np_soma_bruta[0] += (int32_t)r - led->R;
+    np_soma_bruta[1] += (int32_t)g - led->G;
+    np_soma_bruta[2] += (int32_t)b - led->B;
+    np_soma_gamma[0] += (int32_t)np_gamma[r] - np_gamma[led->R];
+    np_soma_gamma[1] += (int32_t)np_gamma[g] - np_gamma[led->G];
+    np_soma_gamma[2] += (int32_t)np_gamma[b] - np_gamma[led->B];
+    led->R = r;
+    led->G = g;
+    led->B = b;
+    np_leds16[index][0] = r * 257u;
+    np_leds16[index][1] = g * 257u;
+    np_leds16[index][2] = b * 257u;
+}
+
+// Pixel com 16 bits por canal. Fora do modo de dithering vale só o byte alto.
+void npSetLED16(uint index, uint16_t r, uint16_t g, uint16_t b)
+{
+    npSetLED(index, r >> 8, g >> 8, b >> 8);
+    np_leds16[index][0] = r;
+    np_leds16[index][1] = g;
+    np_leds16[index][2] = b;
+}
+
+// Refaz as somas do zero, para quem escreve direto em 'leds' (O(LEDs))
+void npRecalcularCorrente(void)
+{
+    for (uint c = 0; c < 3; ++c)
+        np_soma_bruta[c] = np_soma_gamma[c] = 0;
+
     for (uint i = 0; i < LED_COUNT; ++i)
     {
-        pio_sm_put_blocking(np_pio, sm, leds[i].G);
-        pio_sm_put_blocking(np_pio, sm, leds[i].R);
-        pio_sm_put_blocking(np_pio, sm, leds[i].B);
+        np_soma_bruta[0] += leds[i].R;
+        np_soma_bruta[1] += leds[i].G;
+        np_soma_bruta[2] += leds[i].B;
+        np_soma_gamma[0] += np_gamma[leds[i].R];
+        np_soma_gamma[1] += np_gamma[leds[i].G];
+        np_soma_gamma[2] += np_gamma[leds[i].B];
     }
 }
 
-// Função para desligar os leds
-void npClear()
+// Operações em lote sobre o buffer inteiro: um laço do kernel de cor.h e as
+// somas refeitas uma vez, em vez de npSetLED pixel a pixel
+static void np_lote_concluido(void)
 {
+    npRecalcularCorrente();
     for (uint i = 0; i < LED_COUNT; ++i)
     {
-        leds[i].R = 0;
-        leds[i].G = 0;
-        leds[i].B = 0;
+        np_leds16[i][0] = leds[i].R * 257u;
+        np_leds16[i][1] = leds[i].G * 257u;
+        np_leds16[i][2] = leds[i].B * 257u;
     }
+}
 
-    npWrite();
+// Mistura 'cor' em todos os pixels com opacidade alfa (255 = só a cor)
+void npMisturarCor(npColor_t cor, uint8_t alfa)
+{
+    cor_misturar_leds(leds, LED_COUNT, cor, alfa);
+    np_lote_concluido();
+}
+
+// Escala o conteúdo do buffer em 8.8 (256 = 1.0). Diferente de
+// npSetEscalaCanais, altera os próprios pixels.
+void npEscalarCores(uint16_t fator)
+{
+    cor_escalar_leds(leds, LED_COUNT, fator);
+    np_lote_concluido();
+}
+
+// Interpola dois quadros de LED_COUNT pixels para o buffer (t de 0 a 256)
+void npInterpolarQuadros(const npLED_t *a, const npLED_t *b, uint16_t t)
+{
+    cor_lerp_leds(leds, a, b, LED_COUNT, t);
+    np_lote_concluido();
+}
+
+// Orçamento de corrente da matriz em mA (0 desliga o limitador). Acima dele o
+// quadro inteiro é escurecido por um fator global, preservando as cores.
+void npSetLimiteCorrente(uint16_t limite_ma)
+{
+    np_limite_ma = limite_ma;
+}
+
+void npGetCorrente(uint32_t *estimada_ma, uint32_t *limitada_ma)
+{
+    *estimada_ma = np_corrente_estimada_ma;
+    *limitada_ma = np_corrente_limitada_ma;
+}
+
+// Estima a corrente do quadro em 'leds' e calcula o fator do limitador
+static void np_limitar_corrente(void)
+{
+    const int32_t *soma = np_gamma_ativo ? np_soma_gamma : np_soma_bruta;
+    uint32_t ocioso = LED_COUNT * NP_MA_OCIOSO;
+    uint32_t ativo = 0;
+    for (uint c = 0; c < 3; ++c)
+    {
+        uint32_t fator = (np_escala[c] * (np_brilho + 1u)) >> 8;
+        ativo += (((uint32_t)soma[c] * fator) >> 8) * NP_MA_POR_CANAL / 255;
+    }
+
+    np_limite_fator = NP_ESCALA_UM;
+    if (np_limite_ma && ocioso + ativo > np_limite_ma)
+        np_limite_fator = np_limite_ma > ocioso ? ((np_limite_ma - ocioso) * NP_ESCALA_UM) / ativo : 0;
+
+    np_corrente_estimada_ma = ocioso + ativo;
+    np_corrente_limitada_ma = ocioso + ((ativo * np_limite_fator) >> 8);
+}
+
+// Gamma de 16 bits, interpolando entre os 257 pontos da tabela
+static inline uint32_t np_gamma_16(uint32_t v)
+{
+    uint32_t i = v >> 8, frac = v & 0xFF;
+    return np_gamma16[i] + (((np_gamma16[i + 1] - np_gamma16[i]) * frac) >> 8);
+}
+
+// Calcula a saída de 16 bits do quadro no buffer que o refresh não está lendo
+// e troca os buffers de uma vez
+static void np_preparar_alvo16(void)
+{
+    uint8_t livre = np_alvo_atual ^ 1;
+    uint32_t fator[3];
+    for (uint c = 0; c < 3; ++c)
+        fator[c] = (((np_escala[c] * (np_brilho + 1u)) >> 8) * np_limite_fator) >> 8;
+
+    for (uint i = 0; i < LED_COUNT; ++i)
+    {
+        for (uint c = 0; c < 3; ++c)
+        {
+            uint32_t v = np_leds16[i][c];
+            if (np_gamma_ativo)
+                v = np_gamma_16(v);
+            np_alvo16[livre][i][c] = (v * fator[c]) >> 8;
+        }
+    }
+    np_alvo_atual = livre;
 }
 
-// Função para obter a posição correta na matriz 5x5.
+// Um quadro do refresh: sigma-delta de 16 para 8 bits e disparo do DMA.
+// Roda em interrupção (fim do latch) ou, na partida, com as interrupções desligadas.
+static void np_refresh_dither(void)
+{
+    uint32_t inicio = time_us_32();
+    const uint16_t (*alvo)[3] = np_alvo16[np_alvo_atual];
+
+    for (uint i = 0; i < LED_COUNT; ++i)
+    {
+        uint32_t saida[3];
+        for (uint c = 0; c < 3; ++c)
+        {
+            uint32_t acumulado = alvo[i][c] + np_erro[i][c];
+            saida[c] = acumulado >> 8;
+            np_erro[i][c] = acumulado & 0xFF;
+            if (saida[c] > 255)
+                saida[c] = 255;
+        }
+        np_buffer[i] = (saida[1] << 24) | (saida[0] << 16) | (saida[2] << 8);
+    }
+
+    uint32_t fim = time_us_32();
+    np_dither_custo_us = fim - inicio;
+    ++np_dither_quadros;
+    if (fim - np_dither_janela_us >= 1000000u)
+    {
+        np_dither_fps = np_dither_quadros;
+        np_dither_quadros = 0;
+        np_dither_janela_us = fim;
+    }
 
-int getIndex(int x, int y)
+    np_ocupado = true;
+    dma_channel_transfer_from_buffer_now(np_dma, np_buffer, LED_COUNT);
+}
+
+// Liga ou desliga o dithering temporal. Ligado, a matriz é reenviada
+// continuamente (cerca de 1 kHz com 25 LEDs) e npWrite só publica o novo
+// quadro de 16 bits, sem esperar o envio.
+void npSetDithering(bool ativo)
 {
-    // Se a linha for par (0, 2, 4), percorremos da esquerda para a direita.
-    // Se a linha for ímpar (1, 3), percorremos da direita para a esquerda.
-    if (y % 2 == 0)
+    if (ativo == np_dithering)
+        return;
+
+    if (ativo)
     {
-        return 24 - (y * 5 + x); // Linha par (esquerda para direita).
+        memset(np_erro, 0, sizeof(np_erro));
+        np_limitar_corrente();
+        np_preparar_alvo16();
+        np_dither_quadros = 0;
+        np_dither_janela_us = time_us_32();
+
+        uint32_t estado = save_and_disable_interrupts();
+        np_dithering = true;
+        if (!np_ocupado)
+            np_refresh_dither(); // Se há um quadro em andamento, o fim do latch dá a partida
+        restore_interrupts(estado);
     }
     else
     {
-        return 24 - (y * 5 + (4 - x)); // Linha ímpar (direita para esquerda).
+        np_dithering = false;
+        npAguardar(); // O último quadro do refresh termina antes do modo normal
+        np_dither_fps = 0;
     }
 }
 
+// Custo do sigma-delta no último quadro e taxa de refresh do último segundo
+void npGetDithering(uint32_t *custo_us, uint32_t *fps)
+{
+    *custo_us = np_dither_custo_us;
+    *fps = np_dither_fps;
+}
+
+// Empacota os pixels em palavras GRB e dispara o DMA; retorna sem esperar a
+// transmissão. Se o quadro anterior ainda não terminou (incluindo o reset),
+// espera por ele para que dois quadros nunca se emendem.
+void npWrite()
+{
+    if (np_dithering)
+    {
+        np_limitar_corrente();
+        np_preparar_alvo16();
+        return;
+    }
+
+    npAguardar();
+
+    np_limitar_corrente();
+    uint32_t inicio = ciclos_agora();
+    np_converter(leds, np_buffer, LED_COUNT, np_limite_fator);
+    np_ciclos_conversao = ciclos_desde(inicio);
+
+    np_ocupado = true;
+    dma_channel_transfer_from_buffer_now(np_dma, np_buffer, LED_COUNT);
+}
+
+// Ciclos de CPU gastos no estágio de cor (gamma, escala e brilho) do último
+// npWrite, para o quadro inteiro. Vale 0 ou lixo até ciclos_iniciar (ciclos.h)
+// ter sido chamada, o que o Main.c só faz no modo de debug.
+uint32_t npGetCiclosConversao(void)
+{
+    return np_ciclos_conversao;
+}
+
+// true enquanto um quadro está sendo enviado ou no intervalo de latch. No modo
+// de dithering o npWrite nunca espera, então a matriz nunca está ocupada.
+bool npOcupado(void)
+{
+    return np_ocupado && !np_dithering;
+}
+
+void npAguardar(void)
+{
+    while (np_ocupado && !np_dithering)
+        tight_loop_contents();
+}
+
+// Callback chamado (em contexto de interrupção) quando cada quadro é travado nos LEDs
+void npSetCallback(void (*callback)(void))
+{
+    np_callback = callback;
+}
+
+// Função para desligar os leds
+void npClear()
+{
+    for (uint i = 0; i < LED_COUNT; ++i)
+        npSetLED(i, 0, 0, 0);
+
+    npWrite();
+}
+
 void acenderTodaMatrizIntensidade(npColor_t cor, float intensidade)
 {
     // Limitar intensidade entre 0 e 1
@@ -116,22 +577,21 @@ void acenderTodaMatrizIntensidade(npColor_t cor, float intensidade)
     if (intensidade > 1.0f)
         intensidade = 1.0f;
 
+    // A intensidade é aplicada na saída: uma conversão em vez de uma por LED
+    uint16_t escala = (uint16_t)(intensidade * NP_ESCALA_UM);
+    npSetEscalaCanais(escala, escala, escala);
+
     for (int i = 0; i < LED_COUNT; i++)
-    {
-        leds[i].R = (uint8_t)(cor.r * intensidade);
-        leds[i].G = (uint8_t)(cor.g * intensidade);
-        leds[i].B = (uint8_t)(cor.b * intensidade);
-    }
+        npSetLED(i, cor.r, cor.g, cor.b);
     npWrite();
 }
 
-void animar_desenhos(int PERIODO, int num_desenhos, int caixa_de_desenhos[num_desenhos][5][5][3], double intensidade_r, double intensidade_g, double intensidade_b)
+void animar_desenhos(const frame_pack_t *pack)
 {
-
-    for (int i = 0; i < num_desenhos; i++)
+    for (uint8_t i = 0; i < pack->num_quadros; i++)
     {
-        setMatrizDeLEDSComIntensidade(caixa_de_desenhos[i], intensidade_r, intensidade_g, intensidade_b);
-        npWrite();         // Atualiza a matriz de LEDs
-        sleep_ms(PERIODO); // Controla o tempo entre cada quadro
+        fp_decodificar_quadro(pack, i, leds); // Decodifica direto no buffer de LEDs
+        npWrite();                              // Atualiza a matriz de LEDs
+        sleep_ms(pack->quadros[i].duracao_ms);  // Duração de cada quadro
     }
 }
\ No newline at end of file
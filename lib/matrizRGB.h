@@ -1,7 +1,8 @@
 #ifndef MATRIZRGB_H
 #define MATRIZRGB_H
 #include <stdint.h>
-#define LED_COUNT 25
+#include <stdbool.h>
+#include "matriz_geometria.h"
 
 // Definição do pixel/LED
 typedef struct
@@ -28,14 +29,45 @@ typedef struct
 
 extern npColor_t colors[];
 
+// Pacote de quadros na flash (ver framepack.h)
+typedef struct frame_pack frame_pack_t;
+
 // Declaração de funções
 
 void acenderTodaMatrizIntensidade(npColor_t cor, float intensidade);
-void animar_desenhos(int PERIODO, int num_desenhos, int caixa_de_desenhos[num_desenhos][5][5][3], double intensidade_r, double intensidade_g, double intensidade_b);
+void animar_desenhos(const frame_pack_t *pack);
 void npInit(uint8_t pin);
 void npClear();
 void npWrite();
-void setMatrizDeLEDSComIntensidade(int matriz[5][5][3], double intensidadeR, double intensidadeG, double intensidadeB);
-int getIndex(int x, int y);
-extern npLED_t leds[LED_COUNT]; // Torna a variável visível externamente
+bool npOcupado(void);
+void npAguardar(void);
+void npSetCallback(void (*callback)(void));
+void npSetEscalaCanais(uint16_t escala_r, uint16_t escala_g, uint16_t escala_b);
+void npSetBrilho(uint8_t brilho);
+uint8_t npGetBrilho(void);
+void npSetGamma(bool ativo);
+void npConverterCores(const npLED_t *origem, uint32_t *destino, unsigned int n);
+void npSetLED(unsigned int index, uint8_t r, uint8_t g, uint8_t b);
+void npSetLED16(unsigned int index, uint16_t r, uint16_t g, uint16_t b);
+void npSetDithering(bool ativo);
+void npGetDithering(uint32_t *custo_us, uint32_t *fps);
+uint32_t npGetCiclosConversao(void);
+void npRecalcularCorrente(void);
+void npMisturarCor(npColor_t cor, uint8_t alfa);
+void npEscalarCores(uint16_t fator);
+void npInterpolarQuadros(const npLED_t *a, const npLED_t *b, uint16_t t);
+void npSetLimiteCorrente(uint16_t limite_ma);
+void npGetCorrente(uint32_t *estimada_ma, uint32_t *limitada_ma);
+void setMatrizDeLEDSComIntensidade(int matriz[MATRIZ_ALTURA][MATRIZ_LARGURA][3], double intensidadeR, double intensidadeG, double intensidadeB);
+extern npLED_t leds[LED_COUNT]; // Torna a variável visível externamente; prefira npSetLED para escrever
+
+// Tabela de índices físicos por posição lógica (y * MATRIZ_LARGURA + x),
+// montada em tempo de compilação a partir de matriz_geometria.h
+extern const uint16_t np_mapa[];
+
+// Posição (x, y) da matriz lógica para o índice em 'leds'
+static inline int getIndex(int x, int y)
+{
+    return np_mapa[y * MATRIZ_LARGURA + x];
+}
 #endif                          // MATRIZRGB_H
\ No newline at end of file
@@ -0,0 +1,91 @@
+#ifndef MATRIZ_GEOMETRIA_H
+#define MATRIZ_GEOMETRIA_H
+
+// Geometria da matriz de LEDs WS2812. A matriz lógica (x da esquerda para a
+// direita, y de cima para baixo) é formada por MATRIZ_PAINEIS_X x
+// MATRIZ_PAINEIS_Y painéis iguais ligados em cadeia. Cada painel é descrito
+// pela fiação física (largura x altura na ordem dos LEDs, serpentina ou
+// progressiva) e pela rotação com que foi montado. Tudo vira uma tabela de
+// índices calculada em tempo de compilação (np_mapa, em matrizRGB.c).
+//
+// Os valores podem ser trocados aqui ou via -D no CMake. O padrão descreve a
+// matriz 5x5 da BitDogLab: serpentina, montada girada de 180 graus.
+
+#ifndef MATRIZ_PAINEL_LARGURA
+#define MATRIZ_PAINEL_LARGURA 5 // LEDs por linha física do painel
+#endif
+#ifndef MATRIZ_PAINEL_ALTURA
+#define MATRIZ_PAINEL_ALTURA 5 // Linhas físicas do painel
+#endif
+#ifndef MATRIZ_SERPENTINA
+#define MATRIZ_SERPENTINA 1 // 1: linhas ímpares invertidas; 0: todas na mesma direção
+#endif
+#ifndef MATRIZ_ROTACAO
+#define MATRIZ_ROTACAO 180 // 0, 90, 180 ou 270 graus (sentido horário)
+#endif
+#ifndef MATRIZ_PAINEIS_X
+#define MATRIZ_PAINEIS_X 1 // Painéis lado a lado
+#endif
+#ifndef MATRIZ_PAINEIS_Y
+#define MATRIZ_PAINEIS_Y 1 // Fileiras de painéis
+#endif
+#ifndef MATRIZ_PAINEIS_SERPENTINA
+#define MATRIZ_PAINEIS_SERPENTINA 0 // 1: fileiras ímpares de painéis ligadas da direita para a esquerda
+#endif
+
+#define MATRIZ_LEDS_PAINEL (MATRIZ_PAINEL_LARGURA * MATRIZ_PAINEL_ALTURA)
+
+// Tamanho lógico de um painel: 90 e 270 graus trocam largura e altura
+#if MATRIZ_ROTACAO == 0 || MATRIZ_ROTACAO == 180
+#define MATRIZ_PAINEL_LARGURA_LOGICA MATRIZ_PAINEL_LARGURA
+#define MATRIZ_PAINEL_ALTURA_LOGICA MATRIZ_PAINEL_ALTURA
+#elif MATRIZ_ROTACAO == 90 || MATRIZ_ROTACAO == 270
+#define MATRIZ_PAINEL_LARGURA_LOGICA MATRIZ_PAINEL_ALTURA
+#define MATRIZ_PAINEL_ALTURA_LOGICA MATRIZ_PAINEL_LARGURA
+#else
+#error "MATRIZ_ROTACAO deve ser 0, 90, 180 ou 270"
+#endif
+
+#define MATRIZ_LARGURA (MATRIZ_PAINEL_LARGURA_LOGICA * MATRIZ_PAINEIS_X)
+#define MATRIZ_ALTURA (MATRIZ_PAINEL_ALTURA_LOGICA * MATRIZ_PAINEIS_Y)
+#define LED_COUNT (MATRIZ_LARGURA * MATRIZ_ALTURA)
+
+// Posição física (u, v) dentro do painel a partir da posição lógica (x, y)
+#if MATRIZ_ROTACAO == 0
+#define MATRIZ_U(x, y) (x)
+#define MATRIZ_V(x, y) (y)
+#elif MATRIZ_ROTACAO == 90
+#define MATRIZ_U(x, y) (y)
+#define MATRIZ_V(x, y) (MATRIZ_PAINEL_ALTURA - 1 - (x))
+#elif MATRIZ_ROTACAO == 180
+#define MATRIZ_U(x, y) (MATRIZ_PAINEL_LARGURA - 1 - (x))
+#define MATRIZ_V(x, y) (MATRIZ_PAINEL_ALTURA - 1 - (y))
+#else
+#define MATRIZ_U(x, y) (MATRIZ_PAINEL_LARGURA - 1 - (y))
+#define MATRIZ_V(x, y) (x)
+#endif
+
+// Índice do LED dentro do painel, seguindo a fiação
+#define MATRIZ_INDICE_PAINEL(u, v) \
+    ((v) * MATRIZ_PAINEL_LARGURA + ((MATRIZ_SERPENTINA && ((v) & 1)) ? MATRIZ_PAINEL_LARGURA - 1 - (u) : (u)))
+
+// Posição do painel na cadeia
+#define MATRIZ_PAINEL(px, py) \
+    ((py) * MATRIZ_PAINEIS_X + ((MATRIZ_PAINEIS_SERPENTINA && ((py) & 1)) ? MATRIZ_PAINEIS_X - 1 - (px) : (px)))
+
+// Índice físico do LED na posição lógica (x, y). Expressão constante: serve
+// para montar tabelas em tempo de compilação.
+#define MATRIZ_INDICE(x, y)                                                                           \
+    (MATRIZ_PAINEL((x) / MATRIZ_PAINEL_LARGURA_LOGICA, (y) / MATRIZ_PAINEL_ALTURA_LOGICA) *           \
+         MATRIZ_LEDS_PAINEL +                                                                         \
+     MATRIZ_INDICE_PAINEL(MATRIZ_U((x) % MATRIZ_PAINEL_LARGURA_LOGICA, (y) % MATRIZ_PAINEL_ALTURA_LOGICA), \
+                          MATRIZ_V((x) % MATRIZ_PAINEL_LARGURA_LOGICA, (y) % MATRIZ_PAINEL_ALTURA_LOGICA)))
+
+// Mesmo índice a partir da posição linear lógica (y * MATRIZ_LARGURA + x)
+#define MATRIZ_INDICE_LINEAR(i) MATRIZ_INDICE((i) % MATRIZ_LARGURA, (i) / MATRIZ_LARGURA)
+
+#if LED_COUNT > 1024
+#error "Matriz com mais de 1024 LEDs: aumente a tabela np_mapa em matrizRGB.c"
+#endif
+
+#endif // MATRIZ_GEOMETRIA_H
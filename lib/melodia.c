@@ -0,0 +1,77 @@
+#include "melodia.h"
+
+uint8_t melodia_num_trilhas(const uint8_t *dados)
+{
+    return dados[0] == MELODIA_TRILHAS ? dados[1] : 1;
+}
+
+// Início da trilha 'trilha' do asset; NULL se ela não existir
+const uint8_t *melodia_trilha(const uint8_t *dados, uint8_t trilha)
+{
+    if (trilha >= melodia_num_trilhas(dados))
+        return NULL;
+    if (dados[0] != MELODIA_TRILHAS)
+        return dados;
+    const uint8_t *deslocamento = &dados[2 + 2 * trilha];
+    return dados + (deslocamento[0] | (deslocamento[1] << 8));
+}
+
+// Com um asset de várias trilhas, lê a trilha 0
+void melodia_iniciar(melodia_leitor_t *leitor, const uint8_t *dados)
+{
+    leitor->pos = melodia_trilha(dados, 0);
+    leitor->andamento = MELODIA_ANDAMENTO_PADRAO;
+    leitor->duracao = MELODIA_TICKS_SEMINIMA;
+    leitor->ticks = 0;
+    leitor->base_ms = 0;
+    leitor->tempo_ms = 0;
+}
+
+// Decodifica o próximo evento em 'nota'; false no fim da melodia. A duração sai
+// da diferença entre os tempos acumulados antes e depois da nota, então o
+// arredondamento para milissegundos não se acumula ao longo da música.
+bool melodia_proxima(melodia_leitor_t *leitor, note_t *nota)
+{
+    for (;;)
+    {
+        uint8_t byte = *leitor->pos;
+        if (byte == MELODIA_FIM)
+            return false;
+        ++leitor->pos;
+
+        if (byte < MELODIA_DURACAO)
+        {
+            leitor->ticks += leitor->duracao;
+            // 1 tick = 60000 / (andamento * 16) ms
+            uint32_t fim_ms = leitor->base_ms + (uint32_t)(((uint64_t)leitor->ticks * 3750u) / leitor->andamento);
+            nota->note = byte;
+            nota->duration_ms = fim_ms - leitor->tempo_ms;
+            leitor->tempo_ms = fim_ms;
+            return true;
+        }
+
+        if (byte < MELODIA_ANDAMENTO)
+        {
+            leitor->duracao = (byte & 0x3F) + 1;
+        }
+        else if (byte == MELODIA_ANDAMENTO)
+        {
+            // O novo andamento conta a partir do tempo já decorrido
+            uint16_t andamento = leitor->pos[0] | (leitor->pos[1] << 8);
+            leitor->pos += 2;
+            leitor->andamento = andamento ? andamento : MELODIA_ANDAMENTO_PADRAO;
+            leitor->base_ms = leitor->tempo_ms;
+            leitor->ticks = 0;
+        }
+        else if (byte == MELODIA_DURACAO_LONGA)
+        {
+            leitor->duracao = *leitor->pos++;
+            if (leitor->duracao == 0)
+                leitor->duracao = 1;
+        }
+        else
+        {
+            return false; // Código desconhecido: trata como fim
+        }
+    }
+}
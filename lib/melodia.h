@@ -0,0 +1,55 @@
+#ifndef MELODIA_H
+#define MELODIA_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include "buzzer_notas.h"
+
+// Formato compacto de melodia, lido da flash um evento por vez. Os tempos são
+// contados em ticks de 1/64 de semibreve (a semínima tem 16 ticks).
+//
+//   0x00         pausa com a duração atual
+//   0x01 - 0x7F  nota MIDI com a duração atual
+//   0x80 - 0xBF  duração atual = (byte & 0x3F) + 1 ticks (1 a 64)
+//   0xC0 lo hi   andamento em semínimas por minuto (16 bits)
+//   0xC1 n       duração atual = n ticks (1 a 255)
+//   0xFF         fim
+//
+// Uma nota com a mesma duração da anterior custa um byte. O gerador
+// tools/rtttl2melodia converte arquivos RTTTL para este formato.
+//
+// Um asset com várias trilhas começa com um cabeçalho:
+//
+//   0xC2 n (lo hi) x n   n trilhas, cada uma no deslocamento de 16 bits dado
+//                        a partir do início do asset
+//
+// e cada trilha é um fluxo como acima, com o seu próprio fim. Sem cabeçalho o
+// asset é uma trilha só.
+
+#define MELODIA_PAUSA 0x00
+#define MELODIA_DURACAO 0x80
+#define MELODIA_ANDAMENTO 0xC0
+#define MELODIA_DURACAO_LONGA 0xC1
+#define MELODIA_TRILHAS 0xC2
+#define MELODIA_FIM 0xFF
+
+#define MELODIA_TICKS_SEMINIMA 16
+#define MELODIA_ANDAMENTO_PADRAO 63 // Mesmo padrão do RTTTL
+
+typedef struct
+{
+    const uint8_t *pos;
+    uint16_t andamento;
+    uint8_t duracao;   // Duração atual em ticks
+    uint32_t ticks;    // Ticks desde a última troca de andamento
+    uint32_t base_ms;  // Tempo da última troca de andamento
+    uint32_t tempo_ms; // Fim da última nota decodificada
+} melodia_leitor_t;
+
+uint8_t melodia_num_trilhas(const uint8_t *dados);
+const uint8_t *melodia_trilha(const uint8_t *dados, uint8_t trilha);
+void melodia_iniciar(melodia_leitor_t *leitor, const uint8_t *dados);
+bool melodia_proxima(melodia_leitor_t *leitor, note_t *nota);
+
+#endif // MELODIA_H
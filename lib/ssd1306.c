@@ -1,5 +1,12 @@
 #include "ssd1306.h"
 #include "font.h"
+#include <string.h>
+
+// Palavras de endereçamento (SET_COL_ADDR/SET_PAGE_ADDR) que precedem os dados no front_buffer
+#define SSD1306_ADDR_WORDS 7
+
+// Maior lista enviada em uma única transação por ssd1306_command_list
+#define SSD1306_MAX_COMMANDS 32
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c)
 {
@@ -12,120 +19,400 @@ void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_v
   ssd->ram_buffer = calloc(ssd->bufsize, sizeof(uint8_t));
   ssd->ram_buffer[0] = 0x40;
   ssd->port_buffer[0] = 0x80;
+  ssd->front_buffer = calloc(SSD1306_ADDR_WORDS + ssd->bufsize, sizeof(uint16_t));
+  ssd->bytes_sent = 0;
+  ssd->busy = false;
+  ssd->flush_cb = NULL;
+  ssd->flush_ctx = NULL;
+
+  // O DMA escreve palavras de 16 bits no IC_DATA_CMD, no ritmo do DREQ de TX do I2C
+  ssd->dma_channel = dma_claim_unused_channel(true);
+  dma_channel_config c = dma_channel_get_default_config(ssd->dma_channel);
+  channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+  channel_config_set_read_increment(&c, true);
+  channel_config_set_write_increment(&c, false);
+  channel_config_set_dreq(&c, i2c_get_dreq(i2c, true));
+  dma_channel_configure(ssd->dma_channel, &c, &i2c_get_hw(i2c)->data_cmd, ssd->front_buffer, 0, false);
+
+  // A RAM do display começa com lixo, então o primeiro envio deve ser completo
+  ssd->dirty = false;
+  ssd1306_invalidate(ssd);
+  ssd1306_reset_clip(ssd);
 }
 
 void ssd1306_config(ssd1306_t *ssd)
 {
-  ssd1306_command(ssd, SET_DISP | 0x00);
-  ssd1306_command(ssd, SET_MEM_ADDR);
-  ssd1306_command(ssd, 0x01);
-  ssd1306_command(ssd, SET_DISP_START_LINE | 0x00);
-  ssd1306_command(ssd, SET_SEG_REMAP | 0x01);
-  ssd1306_command(ssd, SET_MUX_RATIO);
-  ssd1306_command(ssd, HEIGHT - 1);
-  ssd1306_command(ssd, SET_COM_OUT_DIR | 0x08);
-  ssd1306_command(ssd, SET_DISP_OFFSET);
-  ssd1306_command(ssd, 0x00);
-  ssd1306_command(ssd, SET_COM_PIN_CFG);
-  ssd1306_command(ssd, 0x12);
-  ssd1306_command(ssd, SET_DISP_CLK_DIV);
-  ssd1306_command(ssd, 0x80);
-  ssd1306_command(ssd, SET_PRECHARGE);
-  ssd1306_command(ssd, 0xF1);
-  ssd1306_command(ssd, SET_VCOM_DESEL);
-  ssd1306_command(ssd, 0x30);
-  ssd1306_command(ssd, SET_CONTRAST);
-  ssd1306_command(ssd, 0xFF);
-  ssd1306_command(ssd, SET_ENTIRE_ON);
-  ssd1306_command(ssd, SET_NORM_INV);
-  ssd1306_command(ssd, SET_CHARGE_PUMP);
-  ssd1306_command(ssd, 0x14);
-  ssd1306_command(ssd, SET_DISP | 0x01);
+  // Toda a inicialização vai em uma única transação I2C
+  static const uint8_t init_commands[] = {
+      SET_DISP | 0x00,
+      SET_MEM_ADDR, 0x01,
+      SET_DISP_START_LINE | 0x00,
+      SET_SEG_REMAP | 0x01,
+      SET_MUX_RATIO, HEIGHT - 1,
+      SET_COM_OUT_DIR | 0x08,
+      SET_DISP_OFFSET, 0x00,
+      SET_COM_PIN_CFG, 0x12,
+      SET_DISP_CLK_DIV, 0x80,
+      SET_PRECHARGE, 0xF1,
+      SET_VCOM_DESEL, 0x30,
+      SET_CONTRAST, 0xFF,
+      SET_ENTIRE_ON,
+      SET_NORM_INV,
+      SET_CHARGE_PUMP, 0x14,
+      SET_DISP | 0x01,
+  };
+  ssd1306_command_list(ssd, init_commands, sizeof(init_commands));
 }
 
 void ssd1306_command(ssd1306_t *ssd, uint8_t command)
 {
+  // Não pode intercalar bytes com uma transferência DMA em andamento
+  ssd1306_flush_wait(ssd);
   ssd->port_buffer[1] = command;
-  i2c_write_blocking(
+  int sent = i2c_write_blocking(
       ssd->i2c_port,
       ssd->address,
       ssd->port_buffer,
       2,
       false);
+  if (sent > 0)
+    ssd->bytes_sent += sent;
+}
+
+// Envia vários comandos atrás de um único byte de controle 0x00 (Co = 0),
+// em uma só transação I2C, em vez de um START/endereço/STOP por comando.
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t count)
+{
+  uint8_t buffer[1 + SSD1306_MAX_COMMANDS];
+
+  ssd1306_flush_wait(ssd);
+  buffer[0] = 0x00;
+  while (count > 0)
+  {
+    size_t chunk = count < SSD1306_MAX_COMMANDS ? count : SSD1306_MAX_COMMANDS;
+    memcpy(&buffer[1], commands, chunk);
+    int sent = i2c_write_blocking(
+        ssd->i2c_port,
+        ssd->address,
+        buffer,
+        chunk + 1,
+        false);
+    if (sent > 0)
+      ssd->bytes_sent += sent;
+    commands += chunk;
+    count -= chunk;
+  }
+}
+
+void ssd1306_set_contrast(ssd1306_t *ssd, uint8_t contrast)
+{
+  const uint8_t commands[] = {SET_CONTRAST, contrast};
+  ssd1306_command_list(ssd, commands, sizeof(commands));
+}
+
+// Expande a janela suja para incluir as colunas x0..x1 e as páginas page0..page1
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1)
+{
+  if (!ssd->dirty)
+  {
+    ssd->dirty = true;
+    ssd->dirty_x0 = x0;
+    ssd->dirty_x1 = x1;
+    ssd->dirty_page0 = page0;
+    ssd->dirty_page1 = page1;
+    return;
+  }
+  if (x0 < ssd->dirty_x0)
+    ssd->dirty_x0 = x0;
+  if (x1 > ssd->dirty_x1)
+    ssd->dirty_x1 = x1;
+  if (page0 < ssd->dirty_page0)
+    ssd->dirty_page0 = page0;
+  if (page1 > ssd->dirty_page1)
+    ssd->dirty_page1 = page1;
+}
+
+// Força o próximo envio a transmitir o display inteiro
+void ssd1306_invalidate(ssd1306_t *ssd)
+{
+  ssd1306_mark_dirty(ssd, 0, ssd->width - 1, 0, ssd->pages - 1);
+}
+
+// Restringe todas as primitivas de desenho ao retângulo (x0, y0)-(x1, y1)
+void ssd1306_set_clip(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1)
+{
+  ssd->clip_x0 = x0;
+  ssd->clip_y0 = y0;
+  ssd->clip_x1 = x1 < ssd->width ? x1 : ssd->width - 1;
+  ssd->clip_y1 = y1 < ssd->height ? y1 : ssd->height - 1;
+}
+
+void ssd1306_reset_clip(ssd1306_t *ssd)
+{
+  ssd1306_set_clip(ssd, 0, 0, ssd->width - 1, ssd->height - 1);
+}
+
+// Bits da página que estão dentro das linhas do recorte
+static inline uint8_t ssd1306_clip_page_mask(const ssd1306_t *ssd, int16_t page)
+{
+  int16_t top = page * 8;
+  uint8_t mask = 0xFF;
+  if (ssd->clip_y0 > top)
+    mask &= 0xFF << (ssd->clip_y0 - top < 8 ? ssd->clip_y0 - top : 8);
+  if (ssd->clip_y1 < top + 7)
+    mask &= (ssd->clip_y1 >= top) ? (0xFF >> (7 - (ssd->clip_y1 - top))) : 0;
+  return mask;
+}
+
+// Inicia o envio assíncrono da janela suja. A janela é copiada do ram_buffer
+// (back buffer) para o front_buffer, então o desenho do próximo quadro pode
+// começar imediatamente enquanto o DMA alimenta o I2C. O front_buffer leva duas
+// transações: os comandos de endereçamento (0x00 + 6 bytes, com STOP) e os
+// dados (0x40 + janela, com STOP); o I2C gera o novo START sozinho. O display
+// está em modo de endereçamento vertical: cada coluna da janela ocupa
+// (page1 - page0 + 1) bytes consecutivos na transmissão.
+// Retorna false se já houver uma transferência em andamento ou nada mudou.
+bool ssd1306_flush_start(ssd1306_t *ssd)
+{
+  if (!ssd1306_flush_poll(ssd) || !ssd->dirty)
+    return false;
+
+  uint8_t x0 = ssd->dirty_x0, x1 = ssd->dirty_x1;
+  uint8_t page0 = ssd->dirty_page0, page1 = ssd->dirty_page1;
+
+  uint16_t *words = ssd->front_buffer;
+  size_t len = 0;
+  words[len++] = 0x00;
+  words[len++] = SET_COL_ADDR;
+  words[len++] = x0;
+  words[len++] = x1;
+  words[len++] = SET_PAGE_ADDR;
+  words[len++] = page0;
+  words[len++] = page1 | I2C_IC_DATA_CMD_STOP_BITS;
+
+  // "Troca" de buffers: a janela vai para o front_buffer e o back buffer fica livre
+  uint8_t span = page1 - page0 + 1;
+  words[len++] = 0x40;
+  for (uint16_t x = x0; x <= x1; ++x)
+  {
+    const uint8_t *column = &ssd->ram_buffer[1 + x * ssd->pages + page0];
+    for (uint8_t p = 0; p < span; ++p)
+      words[len++] = column[p];
+  }
+  words[len - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+  ssd->flush_x0 = x0;
+  ssd->flush_x1 = x1;
+  ssd->flush_page0 = page0;
+  ssd->flush_page1 = page1;
+  ssd->flush_len = len;
+  ssd->dirty = false;
+  ssd->busy = true;
+
+  // Mesmo procedimento do SDK para trocar o endereço do escravo
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  hw->enable = 0;
+  hw->tar = ssd->address;
+  hw->enable = 1;
+
+  dma_channel_transfer_from_buffer_now(ssd->dma_channel, words, len);
+  return true;
 }
 
+// Verifica se a transferência assíncrona terminou. O DMA acaba antes do
+// barramento: só consideramos concluído quando o FIFO de TX esvaziou e o
+// mestre ficou ocioso. Retorna true se o display estiver livre.
+bool ssd1306_flush_poll(ssd1306_t *ssd)
+{
+  if (!ssd->busy)
+    return true;
+
+  i2c_hw_t *hw = i2c_get_hw(ssd->i2c_port);
+  if (hw->raw_intr_stat & I2C_IC_RAW_INTR_STAT_TX_ABRT_BITS)
+  {
+    // NACK ou perda de arbitragem: o FIFO fica travado até ler IC_CLR_TX_ABRT.
+    // A janela volta para a região suja para ser reenviada no próximo flush.
+    dma_channel_abort(ssd->dma_channel);
+    (void)hw->clr_tx_abrt;
+    ssd1306_mark_dirty(ssd, ssd->flush_x0, ssd->flush_x1, ssd->flush_page0, ssd->flush_page1);
+  }
+  else if (dma_channel_is_busy(ssd->dma_channel) ||
+           !(hw->status & I2C_IC_STATUS_TFE_BITS) ||
+           (hw->status & I2C_IC_STATUS_MST_ACTIVITY_BITS))
+  {
+    return false;
+  }
+  else
+  {
+    ssd->bytes_sent += ssd->flush_len;
+  }
+
+  ssd->busy = false;
+  if (ssd->flush_cb)
+    ssd->flush_cb(ssd->flush_ctx);
+  return true;
+}
+
+void ssd1306_flush_wait(ssd1306_t *ssd)
+{
+  while (!ssd1306_flush_poll(ssd))
+    tight_loop_contents();
+}
+
+void ssd1306_set_flush_callback(ssd1306_t *ssd, ssd1306_flush_cb_t cb, void *ctx)
+{
+  ssd->flush_cb = cb;
+  ssd->flush_ctx = ctx;
+}
+
+// Envio bloqueante, mantido para quem já usa a API antiga
 void ssd1306_send_data(ssd1306_t *ssd)
 {
-  ssd1306_command(ssd, SET_COL_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->width - 1);
-  ssd1306_command(ssd, SET_PAGE_ADDR);
-  ssd1306_command(ssd, 0);
-  ssd1306_command(ssd, ssd->pages - 1);
-  i2c_write_blocking(
-      ssd->i2c_port,
-      ssd->address,
-      ssd->ram_buffer,
-      ssd->bufsize,
-      false);
+  ssd1306_flush_wait(ssd);
+  if (ssd1306_flush_start(ssd))
+    ssd1306_flush_wait(ssd);
 }
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value)
 {
+  if (x < ssd->clip_x0 || x > ssd->clip_x1 || y < ssd->clip_y0 || y > ssd->clip_y1)
+    return;
+
   uint16_t index = (y >> 3) + (x << 3) + 1;
   uint8_t pixel = (y & 0b111);
-  if (value)
-    ssd->ram_buffer[index] |= (1 << pixel);
-  else
-    ssd->ram_buffer[index] &= ~(1 << pixel);
+  uint8_t old = ssd->ram_buffer[index];
+  uint8_t byte = value ? (old | (1 << pixel)) : (old & ~(1 << pixel));
+
+  // Só marca como sujo se o byte realmente mudou
+  if (byte != old)
+  {
+    ssd->ram_buffer[index] = byte;
+    ssd1306_mark_dirty(ssd, x, x, y >> 3, y >> 3);
+  }
 }
 
-/*
-void ssd1306_fill(ssd1306_t *ssd, bool value) {
-  uint8_t byte = value ? 0xFF : 0x00;
-  for (uint8_t i = 1; i < ssd->bufsize; ++i)
-    ssd->ram_buffer[i] = byte;
-}*/
+// Aplica uma máscara a um byte de página: value liga os bits da máscara, !value apaga.
+// Retorna true se o byte mudou, para o chamador marcar a região suja uma única vez.
+static inline bool ssd1306_apply_mask(uint8_t *byte, uint8_t mask, bool value)
+{
+  uint8_t old = *byte;
+  uint8_t updated = value ? (old | mask) : (old & ~mask);
+  *byte = updated;
+  return updated != old;
+}
+
+// Pinta as linhas y0..y1 (já recortadas, y0 <= y1) da coluna x usando bytes
+// inteiros: máscara no primeiro e no último byte e 0xFF nas páginas do meio.
+static bool ssd1306_column_span(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value)
+{
+  uint8_t *column = &ssd->ram_buffer[1 + x * ssd->pages];
+  uint8_t page0 = y0 >> 3, page1 = y1 >> 3;
+  uint8_t head = 0xFF << (y0 & 7);
+  uint8_t tail = 0xFF >> (7 - (y1 & 7));
+  bool changed;
+
+  if (page0 == page1)
+    return ssd1306_apply_mask(&column[page0], head & tail, value);
+
+  changed = ssd1306_apply_mask(&column[page0], head, value);
+  for (uint8_t page = page0 + 1; page < page1; ++page)
+    changed |= ssd1306_apply_mask(&column[page], 0xFF, value);
+  changed |= ssd1306_apply_mask(&column[page1], tail, value);
+  return changed;
+}
 
 void ssd1306_fill(ssd1306_t *ssd, bool value)
 {
-  // Itera por todas as posições do display
-  for (uint8_t y = 0; y < ssd->height; ++y)
+  // Com recorte ativo, preenche apenas o retângulo de recorte
+  if (ssd->clip_x0 != 0 || ssd->clip_y0 != 0 || ssd->clip_x1 != ssd->width - 1 || ssd->clip_y1 != ssd->height - 1)
   {
-    for (uint8_t x = 0; x < ssd->width; ++x)
+    ssd1306_rect(ssd, ssd->clip_y0, ssd->clip_x0, ssd->clip_x1 - ssd->clip_x0 + 1, ssd->clip_y1 - ssd->clip_y0 + 1, value, true);
+    return;
+  }
+
+  uint8_t byte = value ? 0xFF : 0x00;
+  uint8_t *buffer = &ssd->ram_buffer[1];
+  int16_t x0 = -1, x1 = -1;
+  uint8_t pages_changed = 0;
+
+  // Descobre quais colunas/páginas realmente mudam antes de preencher
+  for (uint8_t x = 0; x < ssd->width; ++x)
+  {
+    const uint8_t *column = &buffer[x * ssd->pages];
+    for (uint8_t page = 0; page < ssd->pages; ++page)
     {
-      ssd1306_pixel(ssd, x, y, value);
+      if (column[page] != byte)
+      {
+        pages_changed |= 1 << page;
+        if (x0 < 0)
+          x0 = x;
+        x1 = x;
+      }
     }
   }
+
+  if (x0 < 0)
+    return;
+
+  memset(buffer, byte, ssd->bufsize - 1);
+
+  uint8_t page0 = 0, page1 = ssd->pages - 1;
+  while (!(pages_changed & (1 << page0)))
+    ++page0;
+  while (!(pages_changed & (1 << page1)))
+    --page1;
+  ssd1306_mark_dirty(ssd, x0, x1, page0, page1);
 }
 
 void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill)
 {
-  for (uint8_t x = left; x < left + width; ++x)
-  {
-    ssd1306_pixel(ssd, x, top, value);
-    ssd1306_pixel(ssd, x, top + height - 1, value);
-  }
-  for (uint8_t y = top; y < top + height; ++y)
-  {
-    ssd1306_pixel(ssd, left, y, value);
-    ssd1306_pixel(ssd, left + width - 1, y, value);
-  }
+  if (width == 0 || height == 0)
+    return;
+
+  int right = left + width - 1;
+  int bottom = top + height - 1;
 
   if (fill)
   {
-    for (uint8_t x = left + 1; x < left + width - 1; ++x)
-    {
-      for (uint8_t y = top + 1; y < top + height - 1; ++y)
-      {
-        ssd1306_pixel(ssd, x, y, value);
-      }
-    }
+    // Preenchido: cada coluna é um único trecho vertical de bytes
+    int x0 = left > ssd->clip_x0 ? left : ssd->clip_x0;
+    int y0 = top > ssd->clip_y0 ? top : ssd->clip_y0;
+    int x1 = right < ssd->clip_x1 ? right : ssd->clip_x1;
+    int y1 = bottom < ssd->clip_y1 ? bottom : ssd->clip_y1;
+    if (x0 > x1 || y0 > y1)
+      return;
+
+    bool changed = false;
+    for (int x = x0; x <= x1; ++x)
+      changed |= ssd1306_column_span(ssd, x, y0, y1, value);
+    if (changed)
+      ssd1306_mark_dirty(ssd, x0, x1, y0 >> 3, y1 >> 3);
+    return;
   }
+
+  // Contorno: hline/vline recortam sozinhas, inclusive bordas fora do display
+  uint8_t r = right > 255 ? 255 : right;
+  uint8_t b = bottom > 255 ? 255 : bottom;
+  ssd1306_hline(ssd, left, r, top, value);
+  ssd1306_hline(ssd, left, r, b, value);
+  ssd1306_vline(ssd, left, top, b, value);
+  ssd1306_vline(ssd, r, top, b, value);
 }
 
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value)
 {
+  // Linhas retas (as bordas do draw_border) usam os caminhos por byte
+  if (y0 == y1)
+  {
+    ssd1306_hline(ssd, x0, x1, y0, value);
+    return;
+  }
+  if (x0 == x1)
+  {
+    ssd1306_vline(ssd, x0, y0, y1, value);
+    return;
+  }
+
   int dx = abs(x1 - x0);
   int dy = abs(y1 - y0);
 
@@ -159,41 +446,57 @@ void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1
 
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value)
 {
-  for (uint8_t x = x0; x <= x1; ++x)
-    ssd1306_pixel(ssd, x, y, value);
+  if (x0 > x1)
+  {
+    uint8_t tmp = x0;
+    x0 = x1;
+    x1 = tmp;
+  }
+  if (y < ssd->clip_y0 || y > ssd->clip_y1 || x1 < ssd->clip_x0 || x0 > ssd->clip_x1)
+    return;
+  if (x0 < ssd->clip_x0)
+    x0 = ssd->clip_x0;
+  if (x1 > ssd->clip_x1)
+    x1 = ssd->clip_x1;
+
+  // Mesmo bit em bytes de colunas consecutivas (passo de ssd->pages no buffer)
+  uint8_t page = y >> 3;
+  uint8_t mask = 1 << (y & 7);
+  uint8_t *byte = &ssd->ram_buffer[1 + x0 * ssd->pages + page];
+  bool changed = false;
+  for (uint16_t x = x0; x <= x1; ++x, byte += ssd->pages)
+    changed |= ssd1306_apply_mask(byte, mask, value);
+
+  if (changed)
+    ssd1306_mark_dirty(ssd, x0, x1, page, page);
 }
 
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value)
 {
-  for (uint8_t y = y0; y <= y1; ++y)
-    ssd1306_pixel(ssd, x, y, value);
+  if (y0 > y1)
+  {
+    uint8_t tmp = y0;
+    y0 = y1;
+    y1 = tmp;
+  }
+  if (x < ssd->clip_x0 || x > ssd->clip_x1 || y1 < ssd->clip_y0 || y0 > ssd->clip_y1)
+    return;
+  if (y0 < ssd->clip_y0)
+    y0 = ssd->clip_y0;
+  if (y1 > ssd->clip_y1)
+    y1 = ssd->clip_y1;
+
+  if (ssd1306_column_span(ssd, x, y0, y1, value))
+    ssd1306_mark_dirty(ssd, x, x, y0 >> 3, y1 >> 3);
 }
 
-// Função para desenhar um caractere
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+// Função para desenhar um caractere.
+// A fonte já está em colunas de 8 bits (bit 0 = linha de cima), no mesmo
+// formato do ssd1306_blit, então o glifo é copiado byte a byte e recortado
+// como qualquer blit (x e y podem ser negativos ou passar da borda).
+void ssd1306_draw_char(ssd1306_t *ssd, char c, int16_t x, int16_t y)
 {
-  uint16_t index = 0;
-  char ver = c;
-  if (c >= 'A' && c <= 'Z')
-  {
-    index = (c - 'A' + 11) * 8; // Para letras maiúsculas
-  }
-  else if (c >= '0' && c <= '9')
-  {
-    index = (c - '0' + 1) * 8; // Adiciona o deslocamento necessário
-  }
-  else if (c >= 'a' && c <= 'z')
-  {
-    index = (c - 'a' + 37) * 8;
-  }
-  for (uint8_t i = 0; i < 8; ++i)
-  {
-    uint8_t line = font[index + i];
-    for (uint8_t j = 0; j < 8; ++j)
-    {
-      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j));
-    }
-  }
+  ssd1306_blit(ssd, x, y, &font[font_lookup[(uint8_t)c] * 8], NULL, 8, 8, SSD1306_ROP_COPY);
 }
 
 void draw_square(ssd1306_t *display, int x, int y) {
@@ -296,39 +599,117 @@ void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y)
 }
 
 
-void ssd1306_draw_bitmap(ssd1306_t *ssd, uint8_t x, uint8_t y, const uint8_t *bitmap, uint8_t width, uint8_t height) {
-    // Calcula a página inicial e o número de páginas do bitmap
-    uint8_t start_page = y / 8;
-    uint8_t num_pages = height / 8;
-    
-    // Ajusta o número de páginas se exceder o limite do display
-    if (start_page + num_pages > ssd->pages) {
-        num_pages = ssd->pages - start_page;
+// Bitmap no formato de páginas: bitmap[coluna + página * width], bit 0 = linha de cima.
+void ssd1306_draw_bitmap(ssd1306_t *ssd, uint8_t x, uint8_t y, const uint8_t *bitmap, uint8_t width, uint8_t height)
+{
+  ssd1306_blit(ssd, x, y, bitmap, NULL, width, height, SSD1306_ROP_COPY);
+}
+
+// Combina os bits de src selecionados por mask no byte de destino.
+// Retorna true se o byte mudou.
+static inline bool ssd1306_rop_byte(uint8_t *dst, uint8_t src, uint8_t mask, ssd1306_rop_t rop)
+{
+  uint8_t old = *dst;
+  uint8_t byte;
+  switch (rop)
+  {
+  case SSD1306_ROP_OR:
+    byte = old | (src & mask);
+    break;
+  case SSD1306_ROP_AND:
+    byte = old & (src | ~mask);
+    break;
+  case SSD1306_ROP_XOR:
+    byte = old ^ (src & mask);
+    break;
+  case SSD1306_ROP_NOT:
+    byte = (old & ~mask) | (~src & mask);
+    break;
+  case SSD1306_ROP_COPY:
+  default:
+    byte = (old & ~mask) | (src & mask);
+    break;
+  }
+  *dst = byte;
+  return byte != old;
+}
+
+// Blitter genérico de sprites. bitmap (e mask, opcional) estão no formato de
+// páginas do ssd1306_draw_bitmap, com (height + 7) / 8 linhas de bytes; bits
+// além de height são ignorados. x e y podem ser quaisquer, inclusive negativos:
+// o que cair fora do display é recortado. Com y desalinhado cada byte de origem
+// é deslocado e dividido entre duas páginas de destino. O recorte do
+// ssd1306_set_clip é respeitado.
+void ssd1306_blit(ssd1306_t *ssd, int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, uint8_t width, uint8_t height, ssd1306_rop_t rop)
+{
+  if (width == 0 || height == 0 || x > ssd->clip_x1 || y > ssd->clip_y1 ||
+      x + width <= ssd->clip_x0 || y + height <= ssd->clip_y0)
+    return;
+
+  // Página e deslocamento de destino da primeira linha (divisão com arredondamento para baixo)
+  int16_t base_page = (y >= 0) ? (y >> 3) : -((7 - y) >> 3);
+  uint8_t shift = y - base_page * 8;
+  uint8_t src_pages = (height + 7) >> 3;
+  uint8_t last_mask = 0xFF >> ((src_pages << 3) - height);
+
+  int16_t col0 = x < ssd->clip_x0 ? ssd->clip_x0 - x : 0;
+  int16_t col1 = (x + width > ssd->clip_x1 + 1) ? (ssd->clip_x1 + 1 - x) : width;
+
+  // Primeira e última página de origem que tocam o recorte
+  int16_t clip_page0 = ssd->clip_y0 >> 3, clip_page1 = ssd->clip_y1 >> 3;
+  int16_t sp0 = 0, sp1 = src_pages - 1;
+  while (sp0 <= sp1 && base_page + sp0 + (shift ? 1 : 0) < clip_page0)
+    ++sp0;
+  while (sp1 >= sp0 && base_page + sp1 > clip_page1)
+    --sp1;
+
+  int16_t changed_x0 = -1, changed_x1 = -1;
+  int16_t changed_p0 = ssd->pages, changed_p1 = -1;
+
+  for (int16_t col = col0; col < col1; ++col)
+  {
+    uint8_t dx = x + col;
+    uint8_t *column = &ssd->ram_buffer[1 + dx * ssd->pages];
+    bool changed = false;
+
+    for (int16_t sp = sp0; sp <= sp1; ++sp)
+    {
+      uint8_t src = bitmap[col + sp * width];
+      uint8_t m = (sp == src_pages - 1) ? last_mask : 0xFF;
+      if (mask)
+        m &= mask[col + sp * width];
+      if (!m)
+        continue;
+
+      int16_t page = base_page + sp;
+      if (page >= clip_page0 && page <= clip_page1 &&
+          ssd1306_rop_byte(&column[page], src << shift, (m << shift) & ssd1306_clip_page_mask(ssd, page), rop))
+      {
+        changed = true;
+        if (page < changed_p0)
+          changed_p0 = page;
+        if (page > changed_p1)
+          changed_p1 = page;
+      }
+      if (shift && page + 1 >= clip_page0 && page + 1 <= clip_page1 &&
+          ssd1306_rop_byte(&column[page + 1], src >> (8 - shift), (m >> (8 - shift)) & ssd1306_clip_page_mask(ssd, page + 1), rop))
+      {
+        changed = true;
+        if (page + 1 < changed_p0)
+          changed_p0 = page + 1;
+        if (page + 1 > changed_p1)
+          changed_p1 = page + 1;
+      }
     }
 
-    // Itera sobre cada coluna do bitmap
-    for (uint8_t x_offset = 0; x_offset < width; x_offset++) {
-        uint8_t current_x = x + x_offset;
-        // Verifica se a coluna atual está dentro dos limites do display
-        if (current_x >= ssd->width) break;
-
-        // Itera sobre cada página do bitmap
-        for (uint8_t page = 0; page < num_pages; page++) {
-            uint8_t current_page = start_page + page;
-            // Verifica se a página atual está dentro dos limites
-            if (current_page >= ssd->pages) break;
-
-            // Obtém o byte correspondente do bitmap
-            uint16_t bitmap_index = x_offset + page * width;
-            uint8_t byte = bitmap[bitmap_index];
-
-            // Calcula a posição no buffer do display
-            uint16_t buffer_index = 1 + current_x + (current_page * ssd->width);
-            
-            // Atualiza o buffer apenas se o índice for válido
-            if (buffer_index < ssd->bufsize) {
-                ssd->ram_buffer[buffer_index] = byte;
-            }
-        }
+    if (changed)
+    {
+      if (changed_x0 < 0)
+        changed_x0 = dx;
+      changed_x1 = dx;
     }
-}
\ No newline at end of file
+  }
+
+  if (changed_x0 >= 0)
+    ssd1306_mark_dirty(ssd, changed_x0, changed_x1, changed_p0, changed_p1);
+}
@@ -1,6 +1,10 @@
+#ifndef SSD1306_H
+#define SSD1306_H
+
 #include <stdlib.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "hardware/dma.h"
 
 #define WIDTH 128
 #define HEIGHT 64
@@ -28,6 +32,19 @@ typedef enum
     SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
+// Operações de rasterização do ssd1306_blit, aplicadas só onde a máscara tem 1
+typedef enum
+{
+    SSD1306_ROP_COPY = 0, // destino = origem
+    SSD1306_ROP_OR,       // liga os pixels acesos da origem
+    SSD1306_ROP_AND,      // apaga os pixels apagados da origem
+    SSD1306_ROP_XOR,      // inverte os pixels acesos da origem (cursor)
+    SSD1306_ROP_NOT,      // destino = origem invertida
+} ssd1306_rop_t;
+
+// Chamado por ssd1306_flush_poll quando uma transferência assíncrona termina
+typedef void (*ssd1306_flush_cb_t)(void *ctx);
+
 typedef struct
 {
     uint8_t width, height, pages, address;
@@ -36,12 +53,34 @@ typedef struct
     uint8_t *ram_buffer;
     size_t bufsize;
     uint8_t port_buffer[2];
+    uint16_t *front_buffer;   // Endereçamento + janela em transmissão, no formato IC_DATA_CMD do I2C
+    bool dirty;               // Existe alguma região alterada desde o último envio
+    uint8_t dirty_x0, dirty_x1;       // Colunas alteradas (inclusivo)
+    uint8_t dirty_page0, dirty_page1; // Páginas alteradas (inclusivo)
+    uint32_t bytes_sent;      // Total de bytes efetivamente enviados pelo I2C
+    int dma_channel;          // Canal DMA que alimenta o FIFO de TX do I2C
+    volatile bool busy;       // Há uma transferência assíncrona em andamento
+    uint8_t flush_x0, flush_x1, flush_page0, flush_page1; // Janela em transmissão
+    size_t flush_len;         // Número de palavras em front_buffer
+    ssd1306_flush_cb_t flush_cb;
+    void *flush_ctx;
+    uint8_t clip_x0, clip_y0, clip_x1, clip_y1; // Retângulo de recorte (inclusivo)
 } ssd1306_t;
 
 void ssd1306_init(ssd1306_t *ssd, uint8_t width, uint8_t height, bool external_vcc, uint8_t address, i2c_inst_t *i2c);
 void ssd1306_config(ssd1306_t *ssd);
 void ssd1306_command(ssd1306_t *ssd, uint8_t command);
+void ssd1306_command_list(ssd1306_t *ssd, const uint8_t *commands, size_t count);
+void ssd1306_set_contrast(ssd1306_t *ssd, uint8_t contrast);
 void ssd1306_send_data(ssd1306_t *ssd);
+bool ssd1306_flush_start(ssd1306_t *ssd);
+bool ssd1306_flush_poll(ssd1306_t *ssd);
+void ssd1306_flush_wait(ssd1306_t *ssd);
+void ssd1306_set_flush_callback(ssd1306_t *ssd, ssd1306_flush_cb_t cb, void *ctx);
+void ssd1306_mark_dirty(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t page0, uint8_t page1);
+void ssd1306_invalidate(ssd1306_t *ssd);
+void ssd1306_set_clip(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+void ssd1306_reset_clip(ssd1306_t *ssd);
 
 void ssd1306_pixel(ssd1306_t *ssd, uint8_t x, uint8_t y, bool value);
 void ssd1306_fill(ssd1306_t *ssd, bool value);
@@ -49,8 +88,11 @@ void ssd1306_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint
 void ssd1306_line(ssd1306_t *ssd, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, bool value);
 void ssd1306_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value);
 void ssd1306_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value);
-void ssd1306_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y);
+void ssd1306_draw_char(ssd1306_t *ssd, char c, int16_t x, int16_t y);
 void ssd1306_draw_string(ssd1306_t *ssd, const char *str, uint8_t x, uint8_t y);
 void draw_border(ssd1306_t *display, uint8_t style);
 void draw_square(ssd1306_t *display, int x, int y);
-void ssd1306_draw_bitmap(ssd1306_t *ssd, uint8_t x, uint8_t y, const uint8_t *bitmap, uint8_t width, uint8_t height);
\ No newline at end of file
+void ssd1306_draw_bitmap(ssd1306_t *ssd, uint8_t x, uint8_t y, const uint8_t *bitmap, uint8_t width, uint8_t height);
+void ssd1306_blit(ssd1306_t *ssd, int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, uint8_t width, uint8_t height, ssd1306_rop_t rop);
+
+#endif // SSD1306_H
@@ -0,0 +1,225 @@
+#include "ssd1306_scene.h"
+#include <string.h>
+
+// Expande a região danificada com a caixa (x, y, width, height)
+static void scene_damage(scene_t *scene, int16_t x, int16_t y, int16_t width, int16_t height)
+{
+  if (width <= 0 || height <= 0)
+    return;
+
+  int16_t x1 = x + width - 1;
+  int16_t y1 = y + height - 1;
+  if (!scene->damaged)
+  {
+    scene->damaged = true;
+    scene->damage_x0 = x;
+    scene->damage_y0 = y;
+    scene->damage_x1 = x1;
+    scene->damage_y1 = y1;
+    return;
+  }
+  if (x < scene->damage_x0)
+    scene->damage_x0 = x;
+  if (y < scene->damage_y0)
+    scene->damage_y0 = y;
+  if (x1 > scene->damage_x1)
+    scene->damage_x1 = x1;
+  if (y1 > scene->damage_y1)
+    scene->damage_y1 = y1;
+}
+
+static void scene_damage_node(scene_t *scene, const scene_node_t *node)
+{
+  if (node->visible)
+    scene_damage(scene, node->x, node->y, node->width, node->height);
+}
+
+// Reserva um nó e o insere na lista de desenho mantendo a ordem de z
+static int scene_add_node(scene_t *scene, scene_node_type_t type, int16_t x, int16_t y, uint8_t width, uint8_t height, int8_t z)
+{
+  if (scene->count >= SCENE_MAX_NODES)
+    return -1;
+
+  int id = scene->count++;
+  scene_node_t *node = &scene->nodes[id];
+  memset(node, 0, sizeof(*node));
+  node->type = type;
+  node->x = x;
+  node->y = y;
+  node->width = width;
+  node->height = height;
+  node->z = z;
+  node->visible = true;
+
+  int pos = id;
+  while (pos > 0 && scene->nodes[scene->order[pos - 1]].z > z)
+  {
+    scene->order[pos] = scene->order[pos - 1];
+    --pos;
+  }
+  scene->order[pos] = id;
+
+  scene_damage_node(scene, node);
+  return id;
+}
+
+void scene_init(scene_t *scene, ssd1306_t *ssd)
+{
+  scene->ssd = ssd;
+  scene->count = 0;
+  scene->damaged = false;
+  scene_invalidate(scene);
+}
+
+int scene_add_rect(scene_t *scene, int16_t x, int16_t y, uint8_t width, uint8_t height, bool fill, int8_t z)
+{
+  int id = scene_add_node(scene, SCENE_RECT, x, y, width, height, z);
+  if (id >= 0)
+  {
+    scene->nodes[id].fill = fill;
+    scene->nodes[id].value = true;
+  }
+  return id;
+}
+
+int scene_add_bitmap(scene_t *scene, int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, uint8_t width, uint8_t height, ssd1306_rop_t rop, int8_t z)
+{
+  int id = scene_add_node(scene, SCENE_BITMAP, x, y, width, height, z);
+  if (id >= 0)
+  {
+    scene->nodes[id].bitmap = bitmap;
+    scene->nodes[id].mask = mask;
+    scene->nodes[id].rop = rop;
+  }
+  return id;
+}
+
+int scene_add_text(scene_t *scene, int16_t x, int16_t y, const char *text, int8_t z)
+{
+  size_t len = strlen(text);
+  uint8_t width = len * 8 > 255 ? 255 : len * 8;
+  int id = scene_add_node(scene, SCENE_TEXT, x, y, width, 8, z);
+  if (id >= 0)
+    scene->nodes[id].text = text;
+  return id;
+}
+
+int scene_add_border(scene_t *scene, uint8_t style, int8_t z)
+{
+  int id = scene_add_node(scene, SCENE_BORDER, 0, 0, scene->ssd->width, scene->ssd->height, z);
+  if (id >= 0)
+    scene->nodes[id].style = style;
+  return id;
+}
+
+// Move um nó: só a união da caixa antiga com a nova é redesenhada
+void scene_move(scene_t *scene, int id, int16_t x, int16_t y)
+{
+  if (id < 0 || id >= scene->count)
+    return;
+
+  scene_node_t *node = &scene->nodes[id];
+  if (node->x == x && node->y == y)
+    return;
+
+  scene_damage_node(scene, node);
+  node->x = x;
+  node->y = y;
+  scene_damage_node(scene, node);
+}
+
+void scene_set_visible(scene_t *scene, int id, bool visible)
+{
+  if (id < 0 || id >= scene->count || scene->nodes[id].visible == visible)
+    return;
+
+  scene_node_t *node = &scene->nodes[id];
+  node->visible = true;
+  scene_damage_node(scene, node);
+  node->visible = visible;
+}
+
+// Força o redesenho da tela inteira (por exemplo, ao voltar para o modo)
+void scene_invalidate(scene_t *scene)
+{
+  scene_damage(scene, 0, 0, scene->ssd->width, scene->ssd->height);
+}
+
+static void scene_draw_node(ssd1306_t *ssd, const scene_node_t *node)
+{
+  switch (node->type)
+  {
+  case SCENE_RECT:
+  {
+    // ssd1306_rect usa coordenadas sem sinal: corta a parte negativa antes
+    int16_t x = node->x, y = node->y;
+    int16_t width = node->width, height = node->height;
+    if (x < 0)
+    {
+      width += x;
+      x = 0;
+    }
+    if (y < 0)
+    {
+      height += y;
+      y = 0;
+    }
+    if (width > 0 && height > 0 && x < ssd->width && y < ssd->height)
+      ssd1306_rect(ssd, y, x, width, height, node->value, node->fill);
+    break;
+  }
+
+  case SCENE_BITMAP:
+    ssd1306_blit(ssd, node->x, node->y, node->bitmap, node->mask, node->width, node->height, node->rop);
+    break;
+
+  case SCENE_TEXT:
+    // Glifos parcialmente fora da tela são recortados pelo blit
+    if (node->y <= -8 || node->y >= ssd->height)
+      break;
+    for (int16_t i = 0, x = node->x; node->text[i] && x < ssd->width; ++i, x += 8)
+    {
+      if (x > -8)
+        ssd1306_draw_char(ssd, node->text[i], x, node->y);
+    }
+    break;
+
+  case SCENE_BORDER:
+    draw_border(ssd, node->style);
+    break;
+  }
+}
+
+// Redesenha a região danificada: limpa só essa região e repinta, em ordem de
+// z e recortados a ela, os nós que a tocam. As alterações entram na janela
+// suja do ssd1306_t, que o próximo flush envia. Retorna false se nada mudou.
+bool scene_render(scene_t *scene)
+{
+  if (!scene->damaged)
+    return false;
+
+  ssd1306_t *ssd = scene->ssd;
+  int16_t x0 = scene->damage_x0 < 0 ? 0 : scene->damage_x0;
+  int16_t y0 = scene->damage_y0 < 0 ? 0 : scene->damage_y0;
+  int16_t x1 = scene->damage_x1 >= ssd->width ? ssd->width - 1 : scene->damage_x1;
+  int16_t y1 = scene->damage_y1 >= ssd->height ? ssd->height - 1 : scene->damage_y1;
+  scene->damaged = false;
+  if (x0 > x1 || y0 > y1)
+    return false;
+
+  ssd1306_set_clip(ssd, x0, y0, x1, y1);
+  ssd1306_fill(ssd, false);
+
+  for (uint8_t i = 0; i < scene->count; ++i)
+  {
+    const scene_node_t *node = &scene->nodes[scene->order[i]];
+    if (!node->visible ||
+        node->x > x1 || node->y > y1 ||
+        node->x + node->width <= x0 || node->y + node->height <= y0)
+      continue;
+    scene_draw_node(ssd, node);
+  }
+
+  ssd1306_reset_clip(ssd);
+  return true;
+}
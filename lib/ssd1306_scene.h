@@ -0,0 +1,56 @@
+#ifndef SSD1306_SCENE_H
+#define SSD1306_SCENE_H
+
+#include "ssd1306.h"
+
+// Camada de cena em modo retido sobre o ssd1306_t: guarda os elementos da tela
+// e, a cada atualização, redesenha apenas a região que mudou (união das caixas
+// antigas e novas). O que fica fora dessa região não é tocado.
+
+#define SCENE_MAX_NODES 16
+
+typedef enum
+{
+    SCENE_RECT,
+    SCENE_BITMAP,
+    SCENE_TEXT,
+    SCENE_BORDER,
+} scene_node_type_t;
+
+typedef struct
+{
+    scene_node_type_t type;
+    int16_t x, y;
+    uint8_t width, height;
+    int8_t z;                // Maior z é desenhado por cima
+    bool visible;
+    bool fill;               // SCENE_RECT: preenchido ou só contorno
+    bool value;              // SCENE_RECT: pixels acesos ou apagados
+    uint8_t style;           // SCENE_BORDER: estilo do draw_border
+    const uint8_t *bitmap;   // SCENE_BITMAP: formato do ssd1306_blit
+    const uint8_t *mask;     // SCENE_BITMAP: máscara opcional
+    ssd1306_rop_t rop;       // SCENE_BITMAP
+    const char *text;        // SCENE_TEXT: uma linha, 8 pixels por caractere
+} scene_node_t;
+
+typedef struct
+{
+    ssd1306_t *ssd;
+    scene_node_t nodes[SCENE_MAX_NODES];
+    uint8_t order[SCENE_MAX_NODES]; // Índices dos nós em ordem crescente de z
+    uint8_t count;
+    bool damaged;
+    int16_t damage_x0, damage_y0, damage_x1, damage_y1; // Região a redesenhar (inclusivo)
+} scene_t;
+
+void scene_init(scene_t *scene, ssd1306_t *ssd);
+int scene_add_rect(scene_t *scene, int16_t x, int16_t y, uint8_t width, uint8_t height, bool fill, int8_t z);
+int scene_add_bitmap(scene_t *scene, int16_t x, int16_t y, const uint8_t *bitmap, const uint8_t *mask, uint8_t width, uint8_t height, ssd1306_rop_t rop, int8_t z);
+int scene_add_text(scene_t *scene, int16_t x, int16_t y, const char *text, int8_t z);
+int scene_add_border(scene_t *scene, uint8_t style, int8_t z);
+void scene_move(scene_t *scene, int id, int16_t x, int16_t y);
+void scene_set_visible(scene_t *scene, int id, bool visible);
+void scene_invalidate(scene_t *scene);
+bool scene_render(scene_t *scene);
+
+#endif // SSD1306_SCENE_H
@@ -0,0 +1,135 @@
+#include "ssd1306_sched.h"
+
+// Chamado pelo ssd1306_flush_poll ao fim de cada envio assíncrono
+static void ssd1306_sched_flush_done(void *ctx)
+{
+  ssd1306_sched_t *sched = ctx;
+  if (!sched->flush_pending)
+    return; // Envio feito por fora do agendador (ssd1306_send_data)
+  sched->flush_pending = false;
+
+  uint32_t elapsed = time_us_64() - sched->flush_start_us;
+
+  sched->stats.flush_last_us = elapsed;
+  if (elapsed > sched->stats.flush_max_us)
+    sched->stats.flush_max_us = elapsed;
+  sched->flush_total_us += elapsed;
+  sched->stats.flush_avg_us = sched->flush_total_us / sched->stats.frames_sent;
+}
+
+// O agendador assume o callback de fim de envio do display
+void ssd1306_sched_init(ssd1306_sched_t *sched, ssd1306_t *ssd, uint16_t fps, bool drop_late)
+{
+  sched->ssd = ssd;
+  sched->drop_late = drop_late;
+  sched->flush_total_us = 0;
+  sched->flush_pending = false;
+  sched->window_frames = 0;
+  sched->stats = (ssd1306_sched_stats_t){0};
+  ssd1306_sched_set_fps(sched, fps);
+  sched->next_frame_us = time_us_64();
+  sched->window_start_us = sched->next_frame_us;
+  ssd1306_set_flush_callback(ssd, ssd1306_sched_flush_done, sched);
+}
+
+// Volta a desenhar depois de um tempo sem chamar begin_frame (outro modo da
+// aplicação): o prazo recomeça agora, sem contar o intervalo parado como
+// quadros descartados, e a janela de FPS é reiniciada.
+void ssd1306_sched_resume(ssd1306_sched_t *sched)
+{
+  sched->next_frame_us = time_us_64();
+  sched->window_start_us = sched->next_frame_us;
+  sched->window_frames = 0;
+  sched->stats.fps_x10 = 0;
+}
+
+void ssd1306_sched_set_fps(ssd1306_sched_t *sched, uint16_t fps)
+{
+  sched->frame_interval_us = 1000000u / (fps ? fps : 1);
+}
+
+// Retorna true quando é hora de desenhar um novo quadro. Entre quadros só
+// verifica o fim do envio anterior, sem bloquear.
+bool ssd1306_sched_begin_frame(ssd1306_sched_t *sched)
+{
+  bool idle = ssd1306_flush_poll(sched->ssd);
+  uint64_t now = time_us_64();
+
+  if (now < sched->next_frame_us)
+    return false;
+
+  if (sched->drop_late)
+  {
+    // Modo com prazo: se o envio anterior ainda ocupa o barramento, este
+    // quadro perde a vez; quadros cujo prazo já passou são descartados.
+    uint64_t late = now - sched->next_frame_us;
+    uint32_t missed = late / sched->frame_interval_us;
+    if (!idle)
+      ++missed;
+    if (missed)
+    {
+      sched->stats.frames_dropped += missed;
+      sched->next_frame_us += (uint64_t)missed * sched->frame_interval_us;
+      if (!idle)
+        return false;
+    }
+  }
+  else if (!idle)
+  {
+    // Sem prazo: espera o barramento liberar e desenha atrasado
+    return false;
+  }
+
+  sched->next_frame_us += sched->frame_interval_us;
+  if (sched->next_frame_us < now)
+    sched->next_frame_us = now + sched->frame_interval_us;
+  return true;
+}
+
+// Fecha o quadro: envia a janela suja, ou conta o quadro como pulado se nada
+// mudou. Só quadros que realmente começaram a sair contam como enviados e
+// entram no FPS e na média de envio.
+void ssd1306_sched_end_frame(ssd1306_sched_t *sched)
+{
+  uint64_t now = time_us_64();
+
+  if (sched->ssd->dirty)
+  {
+    // Com o envio anterior ainda no barramento nada sai agora: a janela suja
+    // segue junto com o próximo quadro, e este conta como descartado
+    if (ssd1306_flush_start(sched->ssd))
+    {
+      ++sched->stats.frames_sent;
+      ++sched->window_frames;
+      sched->flush_start_us = now;
+      sched->flush_pending = true;
+    }
+    else
+    {
+      ++sched->stats.frames_dropped;
+    }
+  }
+  else
+  {
+    ++sched->stats.frames_skipped;
+  }
+
+  uint64_t window = now - sched->window_start_us;
+  if (window >= 1000000u)
+  {
+    sched->stats.fps_x10 = (uint64_t)sched->window_frames * 10000000u / window;
+    sched->window_frames = 0;
+    sched->window_start_us = now;
+  }
+}
+
+// Se nenhuma janela fechou há mais de 2 s (nenhum end_frame nesse tempo), o
+// FPS guardado é velho: informa a taxa da janela em aberto.
+void ssd1306_sched_get_stats(const ssd1306_sched_t *sched, ssd1306_sched_stats_t *stats)
+{
+  *stats = sched->stats;
+
+  uint64_t window = time_us_64() - sched->window_start_us;
+  if (window >= 2000000u)
+    stats->fps_x10 = (uint64_t)sched->window_frames * 10000000u / window;
+}
@@ -0,0 +1,42 @@
+#ifndef SSD1306_SCHED_H
+#define SSD1306_SCHED_H
+
+#include "ssd1306.h"
+
+// Agendador de quadros do display: limita a taxa de atualização a um FPS alvo,
+// pula o envio quando nada mudou e, no modo com prazo, descarta quadros que
+// perderam a vez em vez de atrasar os seguintes.
+
+typedef struct
+{
+    uint32_t frames_sent;      // Quadros efetivamente enviados
+    uint32_t frames_skipped;   // Quadros sem nenhuma mudança (nada enviado)
+    uint32_t frames_dropped;   // Quadros descartados por atraso (modo com prazo) ou com o barramento ocupado
+    uint32_t fps_x10;          // FPS alcançado na última janela de 1 s, vezes 10
+    uint32_t flush_last_us;    // Duração do último envio
+    uint32_t flush_max_us;     // Maior duração de envio
+    uint32_t flush_avg_us;     // Duração média de envio
+} ssd1306_sched_stats_t;
+
+typedef struct
+{
+    ssd1306_t *ssd;
+    uint32_t frame_interval_us;
+    bool drop_late;
+    uint64_t next_frame_us;
+    uint64_t flush_start_us;
+    bool flush_pending;        // O envio em andamento foi iniciado pelo agendador
+    uint64_t flush_total_us;
+    uint64_t window_start_us;
+    uint32_t window_frames;
+    ssd1306_sched_stats_t stats;
+} ssd1306_sched_t;
+
+void ssd1306_sched_init(ssd1306_sched_t *sched, ssd1306_t *ssd, uint16_t fps, bool drop_late);
+void ssd1306_sched_resume(ssd1306_sched_t *sched);
+void ssd1306_sched_set_fps(ssd1306_sched_t *sched, uint16_t fps);
+bool ssd1306_sched_begin_frame(ssd1306_sched_t *sched);
+void ssd1306_sched_end_frame(ssd1306_sched_t *sched);
+void ssd1306_sched_get_stats(const ssd1306_sched_t *sched, ssd1306_sched_stats_t *stats);
+
+#endif // SSD1306_SCHED_H
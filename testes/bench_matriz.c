@@ -0,0 +1,150 @@
+// Benchmark no host do caminho de saída da matriz de LEDs. A transposição das
+// faixas do driver paralelo (npTransporFaixas) é conferida bit a bit contra uma
+// transposição ingênua e as duas são medidas por LED, para comparar com os
+// 30 us que cada LED leva no fio. Os tempos são do host e servem para comparar
+// uma versão com a outra, não como medida da placa.
+//
+// O estágio de cor (np_converter, via npConverterCores) é comparado com o
+// caminho antigo em double de setMatrizDeLEDSComIntensidade: sem gamma e com
+// escalas k/256 os dois têm que dar as mesmas palavras GRB. Os ciclos por
+// quadro na placa aparecem no modo de debug do Main.c (npGetCiclosConversao).
+#include "matrizParalela.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define LEDS_FAIXA 256
+#define REPETICOES 2000
+#define CONFERENCIAS 100000
+#define US_POR_LED_FIO 30
+
+#define QUADROS 200000
+
+static uint32_t cores[LEDS_FAIXA][NP_PARALELO_MAX_FAIXAS];
+static uint8_t planos[LEDS_FAIXA][24];
+static int falhas;
+
+static double agora_ns(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+// Um bit por vez: plano 8 * byte + k tem no bit j o bit 7 - k do byte 'byte'
+// (G, R, B) da faixa j
+static void transpor_ingenuo(const uint32_t grb[NP_PARALELO_MAX_FAIXAS], uint8_t saida[24])
+{
+    memset(saida, 0, 24);
+    for (unsigned byte = 0; byte < 3; ++byte)
+        for (unsigned k = 0; k < 8; ++k)
+            for (unsigned j = 0; j < NP_PARALELO_MAX_FAIXAS; ++j)
+                if (grb[j] >> (31 - 8 * byte - k) & 1)
+                    saida[8 * byte + k] |= 1u << j;
+}
+
+static void conferir_transposicao(void)
+{
+    srand(1);
+    for (unsigned i = 0; i < CONFERENCIAS; ++i)
+    {
+        uint32_t grb[NP_PARALELO_MAX_FAIXAS];
+        for (unsigned j = 0; j < NP_PARALELO_MAX_FAIXAS; ++j)
+            grb[j] = (uint32_t)rand() << 8 ^ (uint32_t)rand() << 16; // Lixo no byte baixo de propósito
+        uint8_t esperado[24], obtido[24];
+        transpor_ingenuo(grb, esperado);
+        npTransporFaixas(grb, obtido);
+        if (memcmp(esperado, obtido, 24) != 0)
+        {
+            printf("transposição diferente da ingênua na conferência %u\n", i);
+            ++falhas;
+            return;
+        }
+    }
+}
+
+// Tempo médio por LED de uma transposição, em ns, para faixas de LEDS_FAIXA
+static double medir_transposicao(void (*transpor)(const uint32_t *, uint8_t *))
+{
+    double inicio = agora_ns();
+    for (unsigned r = 0; r < REPETICOES; ++r)
+        for (unsigned i = 0; i < LEDS_FAIXA; ++i)
+            transpor(cores[i], planos[i]);
+    return (agora_ns() - inicio) / ((double)REPETICOES * LEDS_FAIXA);
+}
+
+static npLED_t quadro[LED_COUNT];
+static uint32_t grb_antigo[LED_COUNT], grb_novo[LED_COUNT];
+
+// Caminho antigo: escala em double por canal e empacotamento no npWrite
+static void converter_antigo(double ir, double ig, double ib)
+{
+    for (unsigned i = 0; i < LED_COUNT; ++i)
+    {
+        uint8_t r = (uint8_t)(float)(quadro[i].R * ir);
+        uint8_t g = (uint8_t)(float)(quadro[i].G * ig);
+        uint8_t b = (uint8_t)(float)(quadro[i].B * ib);
+        grb_antigo[i] = ((uint32_t)g << 24) | ((uint32_t)r << 16) | ((uint32_t)b << 8);
+    }
+}
+
+static void comparar_estagio_cor(void)
+{
+    for (unsigned i = 0; i < LED_COUNT; ++i)
+        quadro[i] = (npLED_t){.R = i * 37, .G = 255 - i * 11, .B = i * 101};
+
+    npSetBrilho(255);
+    npSetGamma(false);
+    for (unsigned k = 0; k <= 256; ++k)
+    {
+        npSetEscalaCanais(k, 256 - k, k / 2);
+        npConverterCores(quadro, grb_novo, LED_COUNT);
+        converter_antigo(k / 256.0, (256 - k) / 256.0, (k / 2) / 256.0);
+        if (memcmp(grb_antigo, grb_novo, sizeof(grb_novo)) != 0)
+        {
+            printf("estágio de cor diferente do caminho em double com escala %u/256\n", k);
+            ++falhas;
+            break;
+        }
+    }
+
+    double inicio = agora_ns();
+    for (unsigned q = 0; q < QUADROS; ++q)
+        converter_antigo(0.5 + (q & 1) / 1024.0, 0.25, 0.75);
+    double antigo = (agora_ns() - inicio) / QUADROS;
+
+    npSetEscalaCanais(128, 64, 192);
+    npSetGamma(true);
+    inicio = agora_ns();
+    for (unsigned q = 0; q < QUADROS; ++q)
+    {
+        quadro[q % LED_COUNT].R = q; // Impede que o compilador tire a conversão do laço
+        npConverterCores(quadro, grb_novo, LED_COUNT);
+    }
+    double novo = (agora_ns() - inicio) / QUADROS;
+
+    printf("%-24s %12s %12s %8s\n", "estágio de cor", "double", "8.8 + gamma", "ganho");
+    printf("%-24s %9.1f ns %9.1f ns %7.1fx\n", "por quadro de 25 (host)", antigo, novo, antigo / novo);
+}
+
+int main(void)
+{
+    for (unsigned i = 0; i < LEDS_FAIXA; ++i)
+        for (unsigned j = 0; j < NP_PARALELO_MAX_FAIXAS; ++j)
+            cores[i][j] = (i * 2654435761u + j * 40503u) << 8;
+
+    conferir_transposicao();
+
+    double ingenuo = medir_transposicao(transpor_ingenuo);
+    double novo = medir_transposicao(npTransporFaixas);
+    printf("%-24s %12s %12s %8s\n", "transposição (8 faixas)", "ingênua", "npTransporFaixas", "ganho");
+    printf("%-24s %9.1f ns %13.1f ns %7.1fx\n", "por LED (host)", ingenuo, novo, ingenuo / novo);
+    printf("no fio: %u us por LED, %u LEDs por faixa = %u us por quadro\n",
+           US_POR_LED_FIO, LEDS_FAIXA, US_POR_LED_FIO * LEDS_FAIXA);
+
+    comparar_estagio_cor();
+
+    printf("bench_matriz: %d falhas\n", falhas);
+    return falhas ? 1 : 0;
+}
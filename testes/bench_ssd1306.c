@@ -0,0 +1,178 @@
+// Benchmark no host das primitivas de desenho do ssd1306.c: as versões pixel a
+// pixel de antes, refeitas aqui sobre o ssd1306_pixel atual, contra as versões
+// que trabalham com bytes inteiros de página, e o glifo desenhado pixel a pixel
+// contra o copiado por colunas. Antes de medir, confere que as duas desenham
+// exatamente o mesmo buffer. Os tempos são do host e servem para comparar uma
+// versão com a outra, não como medida da placa.
+#include "ssd1306.h"
+#include "font.h"
+#include <string.h>
+#include <time.h>
+
+#define REPETICOES 20000
+#define CONFERENCIAS 500
+
+// Versões pixel a pixel
+
+static void antigo_fill(ssd1306_t *ssd, bool value)
+{
+  for (uint8_t y = 0; y < ssd->height; ++y)
+    for (uint8_t x = 0; x < ssd->width; ++x)
+      ssd1306_pixel(ssd, x, y, value);
+}
+
+static void antigo_rect(ssd1306_t *ssd, uint8_t top, uint8_t left, uint8_t width, uint8_t height, bool value, bool fill)
+{
+  for (uint8_t x = left; x < left + width; ++x)
+  {
+    ssd1306_pixel(ssd, x, top, value);
+    ssd1306_pixel(ssd, x, top + height - 1, value);
+  }
+  for (uint8_t y = top; y < top + height; ++y)
+  {
+    ssd1306_pixel(ssd, left, y, value);
+    ssd1306_pixel(ssd, left + width - 1, y, value);
+  }
+
+  if (fill)
+  {
+    for (uint8_t x = left + 1; x < left + width - 1; ++x)
+      for (uint8_t y = top + 1; y < top + height - 1; ++y)
+        ssd1306_pixel(ssd, x, y, value);
+  }
+}
+
+static void antigo_hline(ssd1306_t *ssd, uint8_t x0, uint8_t x1, uint8_t y, bool value)
+{
+  for (uint8_t x = x0; x <= x1; ++x)
+    ssd1306_pixel(ssd, x, y, value);
+}
+
+static void antigo_vline(ssd1306_t *ssd, uint8_t x, uint8_t y0, uint8_t y1, bool value)
+{
+  for (uint8_t y = y0; y <= y1; ++y)
+    ssd1306_pixel(ssd, x, y, value);
+}
+
+static void antigo_draw_char(ssd1306_t *ssd, char c, uint8_t x, uint8_t y)
+{
+  uint16_t index = 0;
+  if (c >= 'A' && c <= 'Z')
+    index = (c - 'A' + 11) * 8;
+  else if (c >= '0' && c <= '9')
+    index = (c - '0' + 1) * 8;
+  else if (c >= 'a' && c <= 'z')
+    index = (c - 'a' + 37) * 8;
+
+  for (uint8_t i = 0; i < 8; ++i)
+  {
+    uint8_t line = font[index + i];
+    for (uint8_t j = 0; j < 8; ++j)
+      ssd1306_pixel(ssd, x + i, y + j, line & (1 << j));
+  }
+}
+
+// Casos: a mesma chamada nas duas versões, com parâmetros que variam com i
+// para o compilador não tirar nada do laço
+
+static void fill_antigo(ssd1306_t *ssd, uint32_t i) { antigo_fill(ssd, i & 1); }
+static void fill_novo(ssd1306_t *ssd, uint32_t i) { ssd1306_fill(ssd, i & 1); }
+
+static void rect_antigo(ssd1306_t *ssd, uint32_t i) { antigo_rect(ssd, 1 + i % 5, 3 + i % 7, 100, 40, i & 1, false); }
+static void rect_novo(ssd1306_t *ssd, uint32_t i) { ssd1306_rect(ssd, 1 + i % 5, 3 + i % 7, 100, 40, i & 1, false); }
+
+static void rect_cheio_antigo(ssd1306_t *ssd, uint32_t i) { antigo_rect(ssd, 1 + i % 5, 3 + i % 7, 60, 30, i & 1, true); }
+static void rect_cheio_novo(ssd1306_t *ssd, uint32_t i) { ssd1306_rect(ssd, 1 + i % 5, 3 + i % 7, 60, 30, i & 1, true); }
+
+static void hline_antigo(ssd1306_t *ssd, uint32_t i) { antigo_hline(ssd, 0, WIDTH - 1, i % HEIGHT, i & 1); }
+static void hline_novo(ssd1306_t *ssd, uint32_t i) { ssd1306_hline(ssd, 0, WIDTH - 1, i % HEIGHT, i & 1); }
+
+static void vline_antigo(ssd1306_t *ssd, uint32_t i) { antigo_vline(ssd, i % WIDTH, 0, HEIGHT - 1, i & 1); }
+static void vline_novo(ssd1306_t *ssd, uint32_t i) { ssd1306_vline(ssd, i % WIDTH, 0, HEIGHT - 1, i & 1); }
+
+// Glifo alinhado à página e desalinhado (ocupa duas páginas)
+static const char texto[] = "ABCXYZ0189abcxyz";
+static char glifo(uint32_t i) { return texto[i % (sizeof(texto) - 1)]; }
+
+static void char_antigo(ssd1306_t *ssd, uint32_t i) { antigo_draw_char(ssd, glifo(i), i % 120, 8 * (i % 7)); }
+static void char_novo(ssd1306_t *ssd, uint32_t i) { ssd1306_draw_char(ssd, glifo(i), i % 120, 8 * (i % 7)); }
+
+static void char_desalinhado_antigo(ssd1306_t *ssd, uint32_t i) { antigo_draw_char(ssd, glifo(i), i % 120, 3 + i % 50); }
+static void char_desalinhado_novo(ssd1306_t *ssd, uint32_t i) { ssd1306_draw_char(ssd, glifo(i), i % 120, 3 + i % 50); }
+
+typedef void (*desenho_t)(ssd1306_t *ssd, uint32_t i);
+
+typedef struct
+{
+  const char *nome;
+  desenho_t antigo;
+  desenho_t novo;
+} caso_t;
+
+static const caso_t casos[] = {
+    {"fill", fill_antigo, fill_novo},
+    {"rect 100x40", rect_antigo, rect_novo},
+    {"rect cheio 60x30", rect_cheio_antigo, rect_cheio_novo},
+    {"hline 128", hline_antigo, hline_novo},
+    {"vline 64", vline_antigo, vline_novo},
+    {"draw_char", char_antigo, char_novo},
+    {"draw_char y!=8k", char_desalinhado_antigo, char_desalinhado_novo},
+};
+
+static i2c_inst_t i2c_host;
+static ssd1306_t tela_antiga, tela_nova;
+
+static double agora_ns(void)
+{
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+// Tempo médio de uma chamada, em ns
+static double medir(ssd1306_t *ssd, desenho_t desenho)
+{
+  double inicio = agora_ns();
+  for (uint32_t i = 0; i < REPETICOES; ++i)
+    desenho(ssd, i);
+  return (agora_ns() - inicio) / REPETICOES;
+}
+
+// As duas versões, partindo do mesmo buffer, têm que deixar o mesmo buffer
+static bool conferir(const caso_t *caso)
+{
+  ssd1306_fill(&tela_antiga, false);
+  ssd1306_fill(&tela_nova, false);
+  for (uint32_t i = 0; i < CONFERENCIAS; ++i)
+  {
+    caso->antigo(&tela_antiga, i * 7919u);
+    caso->novo(&tela_nova, i * 7919u);
+    if (memcmp(tela_antiga.ram_buffer, tela_nova.ram_buffer, tela_nova.bufsize) != 0)
+      return false;
+  }
+  return true;
+}
+
+int main(void)
+{
+  ssd1306_init(&tela_antiga, WIDTH, HEIGHT, false, 0x3C, &i2c_host);
+  ssd1306_init(&tela_nova, WIDTH, HEIGHT, false, 0x3C, &i2c_host);
+
+  int falhas = 0;
+  printf("%-18s %12s %12s %8s\n", "primitiva", "antiga (ns)", "nova (ns)", "ganho");
+  for (size_t c = 0; c < sizeof(casos) / sizeof(casos[0]); ++c)
+  {
+    const caso_t *caso = &casos[c];
+    if (!conferir(caso))
+    {
+      printf("%-18s buffers diferentes\n", caso->nome);
+      ++falhas;
+      continue;
+    }
+
+    double antigo = medir(&tela_antiga, caso->antigo);
+    double novo = medir(&tela_nova, caso->novo);
+    printf("%-18s %12.1f %12.1f %7.1fx\n", caso->nome, antigo, novo, antigo / novo);
+  }
+  return falhas ? 1 : 0;
+}
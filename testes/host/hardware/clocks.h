@@ -0,0 +1,13 @@
+#ifndef HOST_HARDWARE_CLOCKS_H
+#define HOST_HARDWARE_CLOCKS_H
+
+#include "pico/stdlib.h"
+
+enum clock_index
+{
+    clk_sys = 5,
+};
+
+static inline uint32_t clock_get_hz(enum clock_index clk_index) { return 125000000u; }
+
+#endif // HOST_HARDWARE_CLOCKS_H
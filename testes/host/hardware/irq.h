@@ -0,0 +1,16 @@
+#ifndef HOST_HARDWARE_IRQ_H
+#define HOST_HARDWARE_IRQ_H
+
+#include "pico/stdlib.h"
+
+// Os handlers são aceitos e nunca chamados
+#define DMA_IRQ_0 11
+#define DMA_IRQ_1 12
+#define PICO_SHARED_IRQ_HANDLER_DEFAULT_ORDER_PRIORITY 0x80
+
+typedef void (*irq_handler_t)(void);
+
+static inline void irq_add_shared_handler(uint num, irq_handler_t handler, uint8_t order_priority) {}
+static inline void irq_set_enabled(uint num, bool enabled) {}
+
+#endif // HOST_HARDWARE_IRQ_H
@@ -0,0 +1,29 @@
+#ifndef HOST_HARDWARE_PIO_H
+#define HOST_HARDWARE_PIO_H
+
+#include "pico/stdlib.h"
+
+// Blocos PIO só com os FIFOs de saída, para os endereços de destino do DMA
+typedef struct
+{
+    volatile uint32_t txf[4];
+} pio_hw_t;
+
+typedef pio_hw_t *PIO;
+
+typedef struct
+{
+    const uint16_t *instructions;
+    uint8_t length;
+    int8_t origin;
+} pio_program_t;
+
+static pio_hw_t host_pio[2];
+#define pio0 (&host_pio[0])
+#define pio1 (&host_pio[1])
+
+static inline int pio_claim_unused_sm(PIO pio, bool required) { return 0; }
+static inline uint pio_add_program(PIO pio, const pio_program_t *program) { return 0; }
+static inline uint pio_get_dreq(PIO pio, uint sm, bool is_tx) { return 0; }
+
+#endif // HOST_HARDWARE_PIO_H
@@ -0,0 +1,41 @@
+#ifndef HOST_PICO_STDLIB_H
+#define HOST_PICO_STDLIB_H
+
+// SDK mínimo para compilar as bibliotecas de lib/ no host (testes/). Só
+// declara o que os testes usam; não há hardware por trás.
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <time.h>
+
+typedef unsigned int uint;
+typedef int32_t alarm_id_t;
+typedef int64_t (*alarm_callback_t)(alarm_id_t id, void *user_data);
+
+static inline void tight_loop_contents(void) {}
+
+static inline uint64_t time_us_64(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (uint64_t)t.tv_sec * 1000000u + t.tv_nsec / 1000;
+}
+
+static inline uint32_t time_us_32(void) { return (uint32_t)time_us_64(); }
+
+static inline void busy_wait_us(uint64_t us)
+{
+    for (uint64_t fim = time_us_64() + us; time_us_64() < fim;)
+        ;
+}
+
+static inline void sleep_ms(uint32_t ms) { busy_wait_us(ms * 1000ull); }
+
+// Sem alarmes no host: quem chama cai no caminho de espera ativa
+static inline alarm_id_t add_alarm_in_us(uint64_t us, alarm_callback_t callback, void *user_data, bool fire_if_past)
+{
+    return -1;
+}
+
+#endif // HOST_PICO_STDLIB_H
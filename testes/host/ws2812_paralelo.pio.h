@@ -0,0 +1,11 @@
+#ifndef HOST_WS2812_PARALELO_PIO_H
+#define HOST_WS2812_PARALELO_PIO_H
+
+#include "hardware/pio.h"
+
+// No lugar do cabeçalho gerado pelo pioasm: o programa não roda no host
+static const pio_program_t ws2812_paralelo_program = {0};
+
+static inline void ws2812_paralelo_program_init(PIO pio, uint sm, uint offset, uint pin_base, uint num_pins, float freq) {}
+
+#endif // HOST_WS2812_PARALELO_PIO_H
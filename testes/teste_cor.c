@@ -0,0 +1,205 @@
+// Teste no host de lib/cor.c contra contas em ponto flutuante. Percorre todas
+// as entradas de cada função de 8 bits (a de 16 bits em uma grade densa) e
+// exige erro de no máximo 1 LSB em cada canal. No fim mede o custo por pixel
+// das versões em lote, no host (serve para comparar, não como medida da placa;
+// os ciclos por LED no Cortex-M0+ saem no modo de debug do Main.c).
+#include "cor.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define PIXELS_LOTE 4096
+#define REPETICOES_LOTE 2000
+
+static int falhas;
+
+static void verificar(const char *nome, double erro, double limite)
+{
+    bool ok = erro <= limite;
+    printf("%-28s erro máximo %.3f (limite %.3f) %s\n", nome, erro, limite, ok ? "ok" : "FALHOU");
+    if (!ok)
+        ++falhas;
+}
+
+// HSV para RGB de referência, com a mesma fração de setor f/256 (ou f/65536)
+static void hsv_referencia(int setor, double f, double v, double s, double rgb[3])
+{
+    double p = v * (1 - s), q = v * (1 - s * f), t = v * (1 - s * (1 - f));
+    switch (setor)
+    {
+    case 0: rgb[0] = v; rgb[1] = t; rgb[2] = p; break;
+    case 1: rgb[0] = q; rgb[1] = v; rgb[2] = p; break;
+    case 2: rgb[0] = p; rgb[1] = v; rgb[2] = t; break;
+    case 3: rgb[0] = p; rgb[1] = q; rgb[2] = v; break;
+    case 4: rgb[0] = t; rgb[1] = p; rgb[2] = v; break;
+    default: rgb[0] = v; rgb[1] = p; rgb[2] = q; break;
+    }
+}
+
+static double maior(double a, double b) { return a > b ? a : b; }
+
+static double erro_canais(const double ref[3], int r, int g, int b)
+{
+    return maior(fabs(r - ref[0]), maior(fabs(g - ref[1]), fabs(b - ref[2])));
+}
+
+static void teste_div255(void)
+{
+    double erro = 0;
+    for (uint32_t x = 0; x <= 65535; ++x)
+        erro = maior(erro, fabs((double)cor_div255(x) - floor(x / 255.0 + 0.5)));
+    verificar("cor_div255 (exata)", erro, 0);
+}
+
+static void teste_hsv_para_rgb(void)
+{
+    double erro = 0;
+    for (int h = 0; h < COR_MATIZ_VOLTA; ++h)
+        for (int s = 0; s < 256; ++s)
+            for (int v = 0; v < 256; ++v)
+            {
+                npColor_t cor = cor_hsv_para_rgb((cor_hsv_t){h, s, v});
+                double ref[3];
+                hsv_referencia(h >> 8, (h & 0xFF) / 256.0, v, s / 255.0, ref);
+                erro = maior(erro, erro_canais(ref, cor.r, cor.g, cor.b));
+            }
+    verificar("cor_hsv_para_rgb", erro, 1);
+}
+
+static void teste_hsv_para_rgb16(void)
+{
+    double erro = 0;
+    for (uint32_t matiz = 0; matiz < 6u * 65536; matiz += 7)
+        for (int s = 0; s < 256; s += 5)
+            for (int v = 0; v < 256; v += 5)
+            {
+                uint16_t rgb[3];
+                cor_hsv_para_rgb16(matiz, s, v, rgb);
+                double ref[3];
+                hsv_referencia(matiz >> 16, (matiz & 0xFFFF) / 65536.0, v * 257.0, s / 255.0, ref);
+                erro = maior(erro, erro_canais(ref, rgb[0], rgb[1], rgb[2]));
+            }
+    verificar("cor_hsv_para_rgb16", erro, 1);
+}
+
+// Todas as 2^24 cores: ida e volta, e matiz/saturação contra a conta exata
+static void teste_rgb_para_hsv(void)
+{
+    double erro_volta = 0, erro_matiz = 0, erro_saturacao = 0;
+    for (int r = 0; r < 256; ++r)
+        for (int g = 0; g < 256; ++g)
+            for (int b = 0; b < 256; ++b)
+            {
+                npColor_t cor = {r, g, b};
+                cor_hsv_t hsv = cor_rgb_para_hsv(cor);
+                npColor_t volta = cor_hsv_para_rgb(hsv);
+                erro_volta = maior(erro_volta, maior(abs(volta.r - r), maior(abs(volta.g - g), abs(volta.b - b))));
+
+                int max = r > g ? (r > b ? r : b) : (g > b ? g : b);
+                int min = r < g ? (r < b ? r : b) : (g < b ? g : b);
+                double delta = max - min;
+                if (delta == 0)
+                    continue;
+
+                double matiz;
+                if (max == r)
+                    matiz = fmod((g - b) / delta + 6, 6);
+                else if (max == g)
+                    matiz = (b - r) / delta + 2;
+                else
+                    matiz = (r - g) / delta + 4;
+                double d = fabs(hsv.h - matiz * 256);
+                if (d > COR_MATIZ_VOLTA / 2)
+                    d = COR_MATIZ_VOLTA - d;
+                erro_matiz = maior(erro_matiz, d);
+                erro_saturacao = maior(erro_saturacao, fabs(hsv.s - 255 * delta / max));
+            }
+    verificar("rgb->hsv->rgb", erro_volta, 1);
+    verificar("cor_rgb_para_hsv (matiz)", erro_matiz, 1);
+    verificar("cor_rgb_para_hsv (saturação)", erro_saturacao, 1);
+}
+
+static void teste_lerp_misturar_escalar(void)
+{
+    double erro_lerp = 0, erro_misturar = 0, erro_escalar = 0;
+    for (int a = 0; a < 256; ++a)
+        for (int b = 0; b < 256; ++b)
+        {
+            for (int t = 0; t <= 256; ++t)
+            {
+                npColor_t x = cor_lerp((npColor_t){a, b, 0}, (npColor_t){b, a, 255}, t);
+                double ref[3] = {a + (b - a) * t / 256.0, b + (a - b) * t / 256.0, 255 * t / 256.0};
+                erro_lerp = maior(erro_lerp, erro_canais(ref, x.r, x.g, x.b));
+            }
+            for (int alfa = 0; alfa < 256; ++alfa)
+            {
+                npColor_t x = cor_misturar((npColor_t){a, b, 0}, (npColor_t){b, a, 255}, alfa);
+                double ref[3] = {(a * (255.0 - alfa) + b * alfa) / 255, (b * (255.0 - alfa) + a * alfa) / 255, alfa};
+                erro_misturar = maior(erro_misturar, erro_canais(ref, x.r, x.g, x.b));
+            }
+        }
+    for (int c = 0; c < 256; ++c)
+        for (int fator = 0; fator <= 256; ++fator)
+        {
+            npColor_t x = cor_escalar((npColor_t){c, c, c}, fator);
+            erro_escalar = maior(erro_escalar, fabs(x.r - c * fator / 256.0));
+        }
+    verificar("cor_lerp", erro_lerp, 1);
+    verificar("cor_misturar", erro_misturar, 1);
+    verificar("cor_escalar", erro_escalar, 1);
+}
+
+static double agora_ns(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec * 1e9 + t.tv_nsec;
+}
+
+static npLED_t lote_a[PIXELS_LOTE], lote_b[PIXELS_LOTE], lote_destino[PIXELS_LOTE];
+static cor_hsv_t lote_hsv[PIXELS_LOTE];
+
+static void medir_lotes(void)
+{
+    for (int i = 0; i < PIXELS_LOTE; ++i)
+    {
+        lote_a[i] = (npLED_t){i & 0xFF, (i >> 4) & 0xFF, (i * 7) & 0xFF};
+        lote_b[i] = (npLED_t){(i * 3) & 0xFF, i & 0xFF, (i >> 2) & 0xFF};
+        lote_hsv[i] = (cor_hsv_t){(i * 13) % COR_MATIZ_VOLTA, i & 0xFF, 255 - (i & 0xFF)};
+    }
+
+    const double pixels = (double)PIXELS_LOTE * REPETICOES_LOTE;
+    double inicio = agora_ns();
+    for (int k = 0; k < REPETICOES_LOTE; ++k)
+        cor_lerp_leds(lote_destino, lote_a, lote_b, PIXELS_LOTE, k & 0xFF);
+    printf("cor_lerp_leds      %6.2f ns/pixel (host)\n", (agora_ns() - inicio) / pixels);
+
+    inicio = agora_ns();
+    for (int k = 0; k < REPETICOES_LOTE; ++k)
+        cor_misturar_leds(lote_destino, PIXELS_LOTE, (npColor_t){k, 255 - k, 40}, k & 0xFF);
+    printf("cor_misturar_leds  %6.2f ns/pixel (host)\n", (agora_ns() - inicio) / pixels);
+
+    inicio = agora_ns();
+    for (int k = 0; k < REPETICOES_LOTE; ++k)
+        cor_escalar_leds(lote_destino, PIXELS_LOTE, 128 + (k & 0x7F));
+    printf("cor_escalar_leds   %6.2f ns/pixel (host)\n", (agora_ns() - inicio) / pixels);
+
+    inicio = agora_ns();
+    for (int k = 0; k < REPETICOES_LOTE; ++k)
+        cor_hsv_para_leds(lote_destino, lote_hsv, PIXELS_LOTE);
+    printf("cor_hsv_para_leds  %6.2f ns/pixel (host)\n", (agora_ns() - inicio) / pixels);
+}
+
+int main(void)
+{
+    teste_div255();
+    teste_hsv_para_rgb();
+    teste_hsv_para_rgb16();
+    teste_rgb_para_hsv();
+    teste_lerp_misturar_escalar();
+    medir_lotes();
+
+    printf("teste_cor: %d falhas\n", falhas);
+    return falhas ? 1 : 0;
+}
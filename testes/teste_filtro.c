@@ -0,0 +1,217 @@
+// Teste no host de lib/filtro_entrada.c com um traço do ADC (ver
+// testes/dados/joystick_degrau.txt): mede o quanto a saída anda com o joystick
+// parado e quanto tempo ela leva para seguir um degrau, com a configuração do
+// Main.c e com a mediana, e confere os casos de calibração perto dos trilhos.
+// O limiar de 50 contagens que o filtro substituiu roda no mesmo traço, para
+// ter os números de antes ao lado dos de depois.
+//
+// Uso: teste_filtro traco.txt
+#include "filtro_entrada.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TAXA_HZ 2000       // Amostras por segundo do traço
+#define AMOSTRAS_VOLTA 8   // Amostras entregues por volta do laço (4 ms)
+#define AMOSTRAS_CENTRO 64 // Bloco da calibração, como ADC_DMA_BLOCO_MAX
+#define DEGRAU 2000        // Amostra em que o traço sai do repouso
+#define ALVO_DEGRAU 3000
+#define ASSENTAMENTO_MAX_MS 40
+
+static uint16_t traco[8000];
+static size_t traco_n;
+static int falhas;
+
+static void verificar(bool ok, const char *msg)
+{
+    if (!ok)
+    {
+        printf("  FALHOU: %s\n", msg);
+        ++falhas;
+    }
+}
+
+static bool ler_traco(const char *caminho)
+{
+    FILE *f = fopen(caminho, "r");
+    if (!f)
+        return false;
+
+    char linha[256];
+    while (fgets(linha, sizeof(linha), f))
+    {
+        if (linha[0] == '#')
+            continue;
+        char *p = linha, *fim;
+        for (long v = strtol(p, &fim, 10); fim != p && traco_n < sizeof(traco) / sizeof(traco[0]); v = strtol(p, &fim, 10))
+        {
+            traco[traco_n++] = v;
+            p = fim;
+        }
+    }
+    fclose(f);
+    return traco_n > DEGRAU;
+}
+
+// Valor que a saída deve alcançar para uma entrada x parada: zona morta
+// descontada e o resto esticado até o trilho
+static double saida_esperada(const filtro_t *filtro, double x)
+{
+    double c = filtro->centro / (double)(1 << FILTRO_FRACAO);
+    double z = filtro->zona / (double)(1 << FILTRO_FRACAO);
+    if (x > c + z)
+        return c + (x - c - z) * (4095 - c) / (4095 - c - z);
+    if (x < c - z)
+        return c - (c - z - x) * c / (c - z);
+    return c;
+}
+
+typedef struct
+{
+    unsigned mudancas;     // Trocas de valor com o joystick parado
+    int minimo, maximo;    // Faixa da saída parada
+    double assentou_ms;    // Tempo até 90% do degrau (< 0: não chegou)
+    int final;             // Saída no fim do traço
+} medida_t;
+
+// Passa o traço, AMOSTRAS_VOLTA por volta do laço como no Main.c, por 'passo'
+// e mede o repouso antes do degrau e a subida depois dele
+static medida_t medir_traco(int (*passo)(void *ctx, const uint16_t *bloco, size_t n), void *ctx,
+                            double inicial, double alvo)
+{
+    medida_t m = {.minimo = 4095, .maximo = 0, .assentou_ms = -1};
+    double limiar = inicial + 0.9 * (alvo - inicial);
+    int ultima = -1;
+    for (size_t i = AMOSTRAS_CENTRO; i + AMOSTRAS_VOLTA <= traco_n; i += AMOSTRAS_VOLTA)
+    {
+        m.final = passo(ctx, &traco[i], AMOSTRAS_VOLTA);
+        size_t fim = i + AMOSTRAS_VOLTA;
+        if (fim <= DEGRAU)
+        {
+            if (ultima >= 0 && m.final != ultima)
+                ++m.mudancas;
+            m.minimo = m.final < m.minimo ? m.final : m.minimo;
+            m.maximo = m.final > m.maximo ? m.final : m.maximo;
+            ultima = m.final;
+        }
+        else if (m.assentou_ms < 0 && m.final >= limiar)
+        {
+            m.assentou_ms = (fim - DEGRAU) * 1000.0 / TAXA_HZ;
+        }
+    }
+    return m;
+}
+
+static void imprimir_medida(const char *nome, const medida_t *m, double alvo)
+{
+    printf("%-10s repouso %d..%d (%u mudanças) | degrau: 90%% em %.1f ms, final %d (esperado %.0f)\n",
+           nome, m->minimo, m->maximo, m->mudancas, m->assentou_ms, m->final, alvo);
+}
+
+static int passo_filtro(void *ctx, const uint16_t *bloco, size_t n)
+{
+    return filtro_processar(ctx, bloco, n);
+}
+
+static void testar_traco(const char *nome, const filtro_config_t *cfg)
+{
+    filtro_t filtro;
+    filtro_iniciar(&filtro, cfg);
+    verificar(filtro_calibrar_centro(&filtro, traco, AMOSTRAS_CENTRO), "calibração rejeitada");
+
+    double alvo = saida_esperada(&filtro, ALVO_DEGRAU);
+    medida_t m = medir_traco(passo_filtro, &filtro, filtro_valor(&filtro), alvo);
+    imprimir_medida(nome, &m, alvo);
+    verificar(m.mudancas == 0, "a saída andou com o joystick parado");
+    verificar(m.assentou_ms >= 0 && m.assentou_ms <= ASSENTAMENTO_MAX_MS, "degrau lento demais");
+    verificar(fabs(m.final - alvo) <= cfg->histerese + 2, "valor final fora do esperado");
+}
+
+// O tratamento antigo do Main.c, como referência do "antes": uma leitura do
+// ADC por volta do laço (a última do bloco), que só passa quando se afasta
+// mais de 50 contagens do último valor aceito. Só é medido, não conferido.
+#define LIMIAR_ANTIGO 50
+
+static int passo_limiar_antigo(void *ctx, const uint16_t *bloco, size_t n)
+{
+    int *anterior = ctx;
+    int leitura = bloco[n - 1];
+    if (*anterior < 0 || abs(leitura - *anterior) > LIMIAR_ANTIGO)
+        *anterior = leitura;
+    return *anterior;
+}
+
+static void medir_limiar_antigo(void)
+{
+    int anterior = -1;
+    medida_t m = medir_traco(passo_limiar_antigo, &anterior, traco[AMOSTRAS_CENTRO], ALVO_DEGRAU);
+    imprimir_medida("limiar 50", &m, ALVO_DEGRAU);
+}
+
+// Entrada parada em x até a saída assentar
+static uint16_t assentar(filtro_t *filtro, uint16_t x)
+{
+    uint16_t bloco[AMOSTRAS_CENTRO];
+    for (size_t i = 0; i < AMOSTRAS_CENTRO; ++i)
+        bloco[i] = x;
+    for (int k = 0; k < 8; ++k)
+        filtro_processar(filtro, bloco, AMOSTRAS_CENTRO);
+    return filtro_valor(filtro);
+}
+
+// Calibração implausível e zona morta maior que o lado: os fatores não
+// podem estourar e a saída ainda tem que alcançar 0 e 4095
+static void testar_trilhos(const filtro_config_t *base)
+{
+    uint16_t bloco[AMOSTRAS_CENTRO];
+    for (size_t i = 0; i < AMOSTRAS_CENTRO; ++i)
+        bloco[i] = 4000;
+
+    filtro_t filtro;
+    filtro_iniciar(&filtro, base);
+    bool aceita = filtro_calibrar_centro(&filtro, bloco, AMOSTRAS_CENTRO);
+    printf("centro 4000: %s, centro %ld\n", aceita ? "aceito" : "descartado",
+           (long)(filtro.centro >> FILTRO_FRACAO));
+    verificar(!aceita && filtro.centro == 2048 << FILTRO_FRACAO, "centro implausível aceito");
+
+    // A zona do Main.c e uma maior que o lado
+    filtro_config_t configs[2] = {*base, *base};
+    configs[1].zona_morta = 3000;
+    const uint16_t centros[] = {1024, 1994, 3071};
+    for (size_t k = 0; k < 2; ++k)
+    {
+        for (size_t c = 0; c < sizeof(centros) / sizeof(centros[0]); ++c)
+        {
+            for (size_t i = 0; i < AMOSTRAS_CENTRO; ++i)
+                bloco[i] = centros[c];
+            filtro_iniciar(&filtro, &configs[k]);
+            filtro_calibrar_centro(&filtro, bloco, AMOSTRAS_CENTRO);
+            uint16_t alto = assentar(&filtro, 4095);
+            uint16_t baixo = assentar(&filtro, 0);
+            printf("zona %u, centro %u: fatores %u/%u, 4095 -> %u, 0 -> %u\n", configs[k].zona_morta, centros[c],
+                   filtro.fator_abaixo, filtro.fator_acima, alto, baixo);
+            verificar(filtro.fator_acima <= 2u << FILTRO_FATOR_BITS && filtro.fator_abaixo <= 2u << FILTRO_FATOR_BITS, "esticamento acima de 2.0");
+            verificar(alto == 4095 && baixo == 0, "a saída não alcança os trilhos");
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    if (argc != 2 || !ler_traco(argv[1]))
+    {
+        fprintf(stderr, "uso: teste_filtro traco.txt\n");
+        return 2;
+    }
+
+    // Mesma configuração do Main.c, e a mediana como alternativa
+    const filtro_config_t iir = {.decimacao = 3, .tipo = FILTRO_IIR, .iir_shift = 1, .zona_morta = 24, .histerese = 4};
+    const filtro_config_t mediana = {.decimacao = 3, .tipo = FILTRO_MEDIANA, .mediana_n = 5, .zona_morta = 24, .histerese = 4};
+    testar_traco("iir", &iir);
+    testar_traco("mediana", &mediana);
+    medir_limiar_antigo();
+    testar_trilhos(&iir);
+
+    printf("teste_filtro: %d falhas\n", falhas);
+    return falhas ? 1 : 0;
+}
@@ -0,0 +1,69 @@
+// Teste no host da ida e volta Piskel -> frame pack -> matriz: decodifica com
+// lib/framepack.c cada quadro do pack gerado no build (desenhos_numeros) e
+// compara pixel a pixel com a exportação original em assets/numeros.c. Vale
+// para qualquer tipo de quadro que o piskel2pack tenha escolhido (paleta, RLE
+// ou delta), que é o que importa: os bytes do pack mudam com a compressão, os
+// pixels não.
+#include "framepack.h"
+#include "assets/desenhos_numeros.h"
+#include "assets/numeros.c"
+#include <stdio.h>
+#include <string.h>
+
+#define DURACAO_MS 350 // A de add_piskel_asset no CMakeLists.txt
+
+static const char *const nomes_tipo[] = {"paleta", "rgb", "delta", "rle"};
+
+// Pixel do Piskel (0xAABBGGRR) com a transparência multiplicada
+static npLED_t pixel_piskel(uint32_t abgr)
+{
+    uint32_t a = abgr >> 24;
+    return (npLED_t){.R = (abgr & 0xFF) * a / 255,
+                     .G = ((abgr >> 8) & 0xFF) * a / 255,
+                     .B = ((abgr >> 16) & 0xFF) * a / 255};
+}
+
+int main(void)
+{
+    const frame_pack_t *pack = &desenhos_numeros;
+    unsigned falhas = 0;
+
+    if (pack->num_quadros != NUMEROS_FRAME_COUNT || pack->largura != NUMEROS_FRAME_WIDTH ||
+        pack->altura != NUMEROS_FRAME_HEIGHT)
+    {
+        printf("pack com %u quadros %ux%u, esperava %u quadros %ux%u\n", pack->num_quadros, pack->largura,
+               pack->altura, NUMEROS_FRAME_COUNT, NUMEROS_FRAME_WIDTH, NUMEROS_FRAME_HEIGHT);
+        return 1;
+    }
+
+    // Os quadros são decodificados em sequência no mesmo buffer, como no
+    // player: um quadro delta parte do anterior
+    npLED_t matriz[LED_COUNT];
+    memset(matriz, 0, sizeof(matriz));
+    for (uint8_t q = 0; q < pack->num_quadros; ++q)
+    {
+        fp_decodificar_quadro(pack, q, matriz);
+
+        unsigned diferentes = 0;
+        for (unsigned p = 0; p < NUMEROS_FRAME_WIDTH * NUMEROS_FRAME_HEIGHT; ++p)
+        {
+            npLED_t esperado = pixel_piskel(numeros_data[q][p]);
+            const npLED_t *obtido = &matriz[getIndex(p % NUMEROS_FRAME_WIDTH, p / NUMEROS_FRAME_WIDTH)];
+            if (obtido->R != esperado.R || obtido->G != esperado.G || obtido->B != esperado.B)
+            {
+                if (!diferentes)
+                    printf("quadro %u, pixel %u: %u %u %u, esperava %u %u %u\n", q, p, obtido->R, obtido->G,
+                           obtido->B, esperado.R, esperado.G, esperado.B);
+                ++diferentes;
+            }
+        }
+
+        uint8_t tipo = pack->quadros[q].tipo;
+        printf("quadro %u: %-6s %u pixels diferentes\n", q, tipo < 4 ? nomes_tipo[tipo] : "?", diferentes);
+        if (diferentes || pack->quadros[q].duracao_ms != DURACAO_MS)
+            ++falhas;
+    }
+
+    printf("teste_framepack: %u quadros com diferença\n", falhas);
+    return falhas ? 1 : 0;
+}
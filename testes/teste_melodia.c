@@ -0,0 +1,79 @@
+// Teste no host do decodificador de lib/melodia.c: decodifica o tema de Mario
+// Kart gerado pelo rtttl2melodia no build e compara evento a evento com a
+// lista de referência (nota MIDI e duração em ms, uma por linha; '#' comenta).
+// A referência é a trilha 0; as demais trilhas têm que terminar no mesmo ms,
+// senão as vozes se desencontram ao repetir.
+//
+// Uso: teste_melodia referencia.txt
+#include "melodia.h"
+#include "assets/tema_mario_kart.h"
+#include <stdio.h>
+#include <string.h>
+
+int main(int argc, char **argv)
+{
+    if (argc != 2)
+    {
+        fprintf(stderr, "uso: teste_melodia referencia.txt\n");
+        return 2;
+    }
+    FILE *f = fopen(argv[1], "r");
+    if (!f)
+    {
+        fprintf(stderr, "teste_melodia: não foi possível abrir %s\n", argv[1]);
+        return 2;
+    }
+
+    melodia_leitor_t leitor;
+    melodia_iniciar(&leitor, tema_mario_kart);
+
+    char linha[128];
+    unsigned evento = 0, falhas = 0;
+    uint32_t total_ms = 0;
+    while (fgets(linha, sizeof(linha), f))
+    {
+        unsigned nota_ref, ms_ref;
+        if (linha[0] == '#' || sscanf(linha, "%u %u", &nota_ref, &ms_ref) != 2)
+            continue;
+
+        note_t nota;
+        if (!melodia_proxima(&leitor, &nota))
+        {
+            printf("evento %u: a melodia acabou, esperava %u %u\n", evento, nota_ref, ms_ref);
+            ++falhas;
+            break;
+        }
+        if (nota.note != nota_ref || nota.duration_ms != ms_ref)
+        {
+            printf("evento %u: %u %u, esperava %u %u\n", evento, nota.note, nota.duration_ms, nota_ref, ms_ref);
+            ++falhas;
+        }
+        total_ms += nota.duration_ms;
+        ++evento;
+    }
+    fclose(f);
+
+    note_t sobra;
+    if (!falhas && melodia_proxima(&leitor, &sobra))
+    {
+        printf("evento %u: %u %u além do fim da referência\n", evento, sobra.note, sobra.duration_ms);
+        ++falhas;
+    }
+
+    uint8_t num_trilhas = melodia_num_trilhas(tema_mario_kart);
+    for (uint8_t t = 1; t < num_trilhas; ++t)
+    {
+        melodia_iniciar(&leitor, melodia_trilha(tema_mario_kart, t));
+        uint32_t trilha_ms = 0;
+        while (melodia_proxima(&leitor, &sobra))
+            trilha_ms += sobra.duration_ms;
+        if (trilha_ms != total_ms)
+        {
+            printf("trilha %u: %u ms, a trilha 0 tem %u ms\n", t, trilha_ms, total_ms);
+            ++falhas;
+        }
+    }
+
+    printf("teste_melodia: %u trilhas, %u eventos, %u ms, %u diferenças\n", num_trilhas, evento, total_ms, falhas);
+    return falhas ? 1 : 0;
+}
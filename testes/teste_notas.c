@@ -0,0 +1,56 @@
+// Teste no host da tabela de tons de lib/buzzer_notas.h: para as 128 notas MIDI
+// confere o erro em cents do divisor e do wrap calculados em tempo de
+// compilação (TOM_PWM_NOTA) contra o temperamento igual (Lá 4 = 440 Hz), com
+// o clock padrão de 125 MHz e com 133 MHz. Confere também que todo wrap passa
+// do wrap de repouso do slice compartilhado com o LED (4095, ver buzzer.h).
+#include "buzzer_notas.h"
+#include <math.h>
+#include <stdio.h>
+
+#define ERRO_MAX_CENTS 0.1
+#define WRAP_REPOUSO 4095 // BUZZER_WRAP_REPOUSO
+
+// As 128 entradas, expandidas com o BUZZER_CLOCK_HZ em vigor no ponto de uso
+#define TONS_4(n) TOM_PWM_NOTA(n), TOM_PWM_NOTA((n) + 1), TOM_PWM_NOTA((n) + 2), TOM_PWM_NOTA((n) + 3)
+#define TONS_16(n) TONS_4(n), TONS_4((n) + 4), TONS_4((n) + 8), TONS_4((n) + 12)
+#define TONS_128 TONS_16(0), TONS_16(16), TONS_16(32), TONS_16(48), TONS_16(64), TONS_16(80), TONS_16(96), TONS_16(112)
+
+#undef BUZZER_CLOCK_HZ
+#define BUZZER_CLOCK_HZ 125000000
+static const tom_pwm_t tons_125mhz[128] = {TONS_128};
+
+#undef BUZZER_CLOCK_HZ
+#define BUZZER_CLOCK_HZ 133000000
+static const tom_pwm_t tons_133mhz[128] = {TONS_128};
+
+static int conferir(const char *nome, const tom_pwm_t tons[128], double clock_hz)
+{
+    double pior = 0;
+    int pior_nota = 0, falhas = 0;
+    for (int n = 0; n < 128; ++n)
+    {
+        double divisor = tons[n].div_int + tons[n].div_frac / 16.0;
+        double f = clock_hz / (divisor * (tons[n].wrap + 1.0));
+        double cents = 1200 * log2(f / (440 * pow(2, (n - 69) / 12.0)));
+        if (fabs(cents) > fabs(pior))
+        {
+            pior = cents;
+            pior_nota = n;
+        }
+        if (fabs(cents) >= ERRO_MAX_CENTS || tons[n].wrap <= WRAP_REPOUSO)
+        {
+            printf("%s nota %d: div %u + %u/16, wrap %u, %.4f cents\n", nome, n, tons[n].div_int,
+                   tons[n].div_frac, tons[n].wrap, cents);
+            ++falhas;
+        }
+    }
+    printf("%s: pior erro %+.4f cents (nota %d), %d fora do limite\n", nome, pior, pior_nota, falhas);
+    return falhas;
+}
+
+int main(void)
+{
+    int falhas = conferir("125 MHz", tons_125mhz, 125e6) + conferir("133 MHz", tons_133mhz, 133e6);
+    printf("teste_notas: %d falhas\n", falhas);
+    return falhas ? 1 : 0;
+}
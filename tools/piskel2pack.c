@@ -0,0 +1,384 @@
+// piskel2pack: ferramenta do host que converte o export em C do Piskel em um
+// frame pack (lib/framepack.h) pronto para ficar na flash. Roda durante o
+// build (ver add_piskel_asset no CMakeLists.txt), então não há mais cópia
+// manual de valores para o Desenho.c.
+//
+// Uso: piskel2pack [-n nome] [-d duracao_ms] [-c auto|paleta|rle|delta] -o saida.c -H saida.h entrada.c
+//
+// O Piskel grava cada pixel como 0xAABBGGRR (R no byte menos significativo).
+// Pixels transparentes viram preto e a transparência parcial é multiplicada
+// na cor, já que o LED não tem fundo para misturar.
+//
+// Compressão (-c): cada quadro é gravado no menor formato permitido.
+//   paleta: só quadros completos com índices de paleta
+//   rle:    paleta ou pares (quantidade, índice)
+//   delta:  paleta ou só os pixels que mudaram em relação ao quadro anterior
+//   auto:   o menor dos três (padrão)
+// Com mais de 256 cores os quadros são gravados em RGB, sem compressão.
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define MAX_CORES 256
+
+// Mesmos valores de fp_tipo_quadro_t
+enum
+{
+    QUADRO_PALETA = 0,
+    QUADRO_RGB = 1,
+    QUADRO_DELTA = 2,
+    QUADRO_RLE = 3,
+};
+
+static const char *nomes_tipo[] = {"FP_QUADRO_PALETA", "FP_QUADRO_RGB", "FP_QUADRO_DELTA", "FP_QUADRO_RLE"};
+
+enum
+{
+    COMPRIMIR_PALETA = 1 << QUADRO_PALETA,
+    COMPRIMIR_DELTA = 1 << QUADRO_DELTA,
+    COMPRIMIR_RLE = 1 << QUADRO_RLE,
+};
+
+typedef struct
+{
+    uint8_t tipo;
+    uint16_t tamanho; // Trios (delta) ou pares (RLE)
+    uint8_t *dados;
+    size_t bytes;
+} quadro_t;
+
+static void erro(const char *msg, const char *detalhe)
+{
+    fprintf(stderr, "piskel2pack: %s%s%s\n", msg, detalhe ? ": " : "", detalhe ? detalhe : "");
+    exit(1);
+}
+
+static char *ler_arquivo(const char *caminho)
+{
+    FILE *f = fopen(caminho, "rb");
+    if (!f)
+        erro("não foi possível abrir", caminho);
+
+    fseek(f, 0, SEEK_END);
+    long tamanho = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    char *texto = malloc(tamanho + 1);
+    if (!texto || fread(texto, 1, tamanho, f) != (size_t)tamanho)
+        erro("falha ao ler", caminho);
+    texto[tamanho] = '\0';
+    fclose(f);
+    return texto;
+}
+
+// Valor do primeiro "#define ..._<sufixo> <n>" do export
+static long ler_define(const char *texto, const char *sufixo)
+{
+    const char *p = texto;
+    while ((p = strstr(p, "#define")) != NULL)
+    {
+        p += 7;
+        while (*p == ' ' || *p == '\t')
+            ++p;
+        const char *nome = p;
+        while (isalnum((unsigned char)*p) || *p == '_')
+            ++p;
+        size_t len = p - nome, len_sufixo = strlen(sufixo);
+        if (len >= len_sufixo && strncmp(nome + len - len_sufixo, sufixo, len_sufixo) == 0)
+            return strtol(p, NULL, 0);
+    }
+    erro("define não encontrado", sufixo);
+    return 0;
+}
+
+// Converte 0xAABBGGRR em RGB com a transparência multiplicada
+static uint32_t converter_pixel(uint32_t abgr)
+{
+    uint32_t a = abgr >> 24;
+    uint32_t r = (abgr & 0xFF) * a / 255;
+    uint32_t g = ((abgr >> 8) & 0xFF) * a / 255;
+    uint32_t b = ((abgr >> 16) & 0xFF) * a / 255;
+    return (r << 16) | (g << 8) | b;
+}
+
+static uint8_t *alocar(size_t bytes)
+{
+    uint8_t *p = calloc(bytes ? bytes : 1, 1);
+    if (!p)
+        erro("sem memória", NULL);
+    return p;
+}
+
+static void quadro_paleta(quadro_t *q, const uint8_t *indices, size_t num_pixels, unsigned bpp)
+{
+    q->tipo = QUADRO_PALETA;
+    q->tamanho = 0;
+    q->bytes = (num_pixels * bpp + 7) / 8;
+    q->dados = alocar(q->bytes);
+    for (size_t p = 0, bit = 0; p < num_pixels; ++p, bit += bpp)
+        q->dados[bit >> 3] |= indices[p] << (bit & 7); // LSB primeiro, como no decodificador
+}
+
+static void quadro_rle(quadro_t *q, const uint8_t *indices, size_t num_pixels)
+{
+    q->tipo = QUADRO_RLE;
+    q->dados = alocar(num_pixels * 2);
+    size_t pares = 0;
+    for (size_t p = 0; p < num_pixels;)
+    {
+        uint8_t quantidade = 1;
+        while (p + quantidade < num_pixels && quantidade < 255 && indices[p + quantidade] == indices[p])
+            ++quantidade;
+        q->dados[pares * 2] = quantidade;
+        q->dados[pares * 2 + 1] = indices[p];
+        ++pares;
+        p += quantidade;
+    }
+    q->tamanho = pares;
+    q->bytes = pares * 2;
+}
+
+static void quadro_delta(quadro_t *q, const uint8_t *indices, const uint8_t *anterior, size_t num_pixels)
+{
+    q->tipo = QUADRO_DELTA;
+    q->dados = alocar(num_pixels * 3);
+    size_t trios = 0;
+    for (size_t p = 0; p < num_pixels; ++p)
+    {
+        if (indices[p] == anterior[p])
+            continue;
+        q->dados[trios * 3] = p & 0xFF;
+        q->dados[trios * 3 + 1] = p >> 8;
+        q->dados[trios * 3 + 2] = indices[p];
+        ++trios;
+    }
+    q->tamanho = trios;
+    q->bytes = trios * 3;
+}
+
+static void escolher_menor(quadro_t *melhor, quadro_t *candidato)
+{
+    if (candidato->bytes < melhor->bytes)
+    {
+        free(melhor->dados);
+        *melhor = *candidato;
+    }
+    else
+    {
+        free(candidato->dados);
+    }
+}
+
+static void escrever_bytes(FILE *f, const uint8_t *dados, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; ++i)
+        fprintf(f, "%s0x%02x,", i % 16 ? " " : "\n    ", dados[i]);
+    fprintf(f, "\n");
+}
+
+static const char *nome_arquivo(const char *caminho)
+{
+    const char *barra = strrchr(caminho, '/');
+    return barra ? barra + 1 : caminho;
+}
+
+// Guarda de inclusão no estilo de lib/: nome em maiúsculas + _H
+static void escrever_guarda(FILE *f, const char *nome, const char *diretiva)
+{
+    fprintf(f, "%s ", diretiva);
+    for (const char *c = nome; *c; ++c)
+        fputc(isalnum((unsigned char)*c) ? toupper((unsigned char)*c) : '_', f);
+    fprintf(f, "_H\n");
+}
+
+static void uso(void)
+{
+    fprintf(stderr, "uso: piskel2pack [-n nome] [-d duracao_ms] [-c auto|paleta|rle|delta] -o saida.c -H saida.h entrada.c\n");
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    const char *nome = "animacao", *saida_c = NULL, *saida_h = NULL, *entrada = NULL;
+    long duracao = 100;
+    unsigned permitidos = COMPRIMIR_PALETA | COMPRIMIR_RLE | COMPRIMIR_DELTA;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] != '-')
+        {
+            entrada = argv[i];
+            continue;
+        }
+        if (i + 1 >= argc)
+            uso();
+        const char *valor = argv[++i];
+        switch (argv[i - 1][1])
+        {
+        case 'n':
+            nome = valor;
+            break;
+        case 'd':
+            duracao = strtol(valor, NULL, 0);
+            break;
+        case 'o':
+            saida_c = valor;
+            break;
+        case 'H':
+            saida_h = valor;
+            break;
+        case 'c':
+            if (strcmp(valor, "paleta") == 0)
+                permitidos = COMPRIMIR_PALETA;
+            else if (strcmp(valor, "rle") == 0)
+                permitidos = COMPRIMIR_PALETA | COMPRIMIR_RLE;
+            else if (strcmp(valor, "delta") == 0)
+                permitidos = COMPRIMIR_PALETA | COMPRIMIR_DELTA;
+            else if (strcmp(valor, "auto") != 0)
+                uso();
+            break;
+        default:
+            uso();
+        }
+    }
+    if (!entrada || !saida_c || !saida_h)
+        uso();
+    if (duracao <= 0 || duracao > 65535)
+        erro("duração fora de 1..65535 ms", NULL);
+
+    char *texto = ler_arquivo(entrada);
+    long num_quadros = ler_define(texto, "_FRAME_COUNT");
+    long largura = ler_define(texto, "_FRAME_WIDTH");
+    long altura = ler_define(texto, "_FRAME_HEIGHT");
+    if (num_quadros < 1 || num_quadros > 255 || largura < 1 || largura > 255 || altura < 1 || altura > 255)
+        erro("dimensões fora do suportado pelo frame pack", entrada);
+
+    size_t num_pixels = (size_t)largura * altura;
+    size_t total = num_pixels * num_quadros;
+
+    // Os pixels vêm depois do '=' da declaração do array de dados
+    const char *p = strstr(texto, "_data");
+    p = p ? strchr(p, '=') : NULL;
+    if (!p)
+        erro("array de dados não encontrado", entrada);
+
+    uint32_t *pixels = malloc(total * sizeof(uint32_t));
+    size_t lidos = 0;
+    while (lidos < total && (p = strstr(p, "0x")) != NULL)
+    {
+        char *fim;
+        pixels[lidos++] = converter_pixel(strtoul(p, &fim, 16));
+        p = fim;
+    }
+    if (lidos != total)
+        erro("quantidade de pixels diferente de FRAME_COUNT * WIDTH * HEIGHT", entrada);
+
+    // Paleta com o preto sempre no índice 0
+    uint32_t paleta[MAX_CORES];
+    size_t num_cores = 1;
+    paleta[0] = 0;
+    uint8_t *indices = alocar(total);
+    for (size_t i = 0; i < total && num_cores <= MAX_CORES; ++i)
+    {
+        size_t c = 0;
+        while (c < num_cores && paleta[c] != pixels[i])
+            ++c;
+        if (c == num_cores && num_cores++ < MAX_CORES)
+            paleta[c] = pixels[i];
+        indices[i] = c;
+    }
+    int rgb = num_cores > MAX_CORES;
+
+    unsigned bpp = 1;
+    while (!rgb && (1u << bpp) < num_cores)
+        bpp *= 2;
+
+    quadro_t *quadros = calloc(num_quadros, sizeof(quadro_t));
+    size_t bytes_total = 0;
+    for (long q = 0; q < num_quadros; ++q)
+    {
+        const uint8_t *atual = &indices[q * num_pixels];
+        quadro_t *melhor = &quadros[q], candidato;
+
+        if (rgb)
+        {
+            melhor->tipo = QUADRO_RGB;
+            melhor->bytes = num_pixels * 3;
+            melhor->dados = alocar(melhor->bytes);
+            for (size_t i = 0; i < num_pixels; ++i)
+            {
+                uint32_t cor = pixels[q * num_pixels + i];
+                melhor->dados[i * 3] = cor >> 16;
+                melhor->dados[i * 3 + 1] = cor >> 8;
+                melhor->dados[i * 3 + 2] = cor;
+            }
+        }
+        else
+        {
+            quadro_paleta(melhor, atual, num_pixels, bpp);
+            if (permitidos & COMPRIMIR_RLE)
+            {
+                quadro_rle(&candidato, atual, num_pixels);
+                escolher_menor(melhor, &candidato);
+            }
+            if ((permitidos & COMPRIMIR_DELTA) && q > 0 && num_pixels <= 65536)
+            {
+                quadro_delta(&candidato, atual, atual - num_pixels, num_pixels);
+                escolher_menor(melhor, &candidato);
+            }
+        }
+        bytes_total += melhor->bytes;
+    }
+
+    FILE *h = fopen(saida_h, "w");
+    if (!h)
+        erro("não foi possível criar", saida_h);
+    fprintf(h, "// Gerado por tools/piskel2pack a partir de %s. Não editar.\n", nome_arquivo(entrada));
+    escrever_guarda(h, nome, "#ifndef");
+    escrever_guarda(h, nome, "#define");
+    fprintf(h, "\n#include \"lib/framepack.h\"\n\n");
+    fprintf(h, "extern const frame_pack_t %s;\n", nome);
+    fprintf(h, "\n");
+    escrever_guarda(h, nome, "#endif //");
+    fclose(h);
+
+    FILE *c = fopen(saida_c, "w");
+    if (!c)
+        erro("não foi possível criar", saida_c);
+    fprintf(c, "// Gerado por tools/piskel2pack a partir de %s. Não editar.\n", nome_arquivo(entrada));
+    fprintf(c, "#include \"%s\"\n\n", nome_arquivo(saida_h));
+
+    if (!rgb)
+    {
+        fprintf(c, "static const npColor_t %s_paleta[] = {\n", nome);
+        for (size_t i = 0; i < num_cores; ++i)
+            fprintf(c, "    {%u, %u, %u},\n", paleta[i] >> 16, (paleta[i] >> 8) & 0xFF, paleta[i] & 0xFF);
+        fprintf(c, "};\n\n");
+    }
+    for (long q = 0; q < num_quadros; ++q)
+    {
+        fprintf(c, "static const uint8_t %s_q%ld[] = {", nome, q);
+        escrever_bytes(c, quadros[q].dados, quadros[q].bytes);
+        fprintf(c, "};\n");
+    }
+    fprintf(c, "\nstatic const fp_quadro_t %s_quadros[] = {\n", nome);
+    for (long q = 0; q < num_quadros; ++q)
+        fprintf(c, "    {%ld, %s, %u, %s_q%ld},\n", duracao, nomes_tipo[quadros[q].tipo], quadros[q].tamanho, nome, q);
+    fprintf(c, "};\n\n");
+
+    fprintf(c, "const frame_pack_t %s = {\n", nome);
+    fprintf(c, "    .largura = %ld,\n    .altura = %ld,\n    .num_quadros = %ld,\n", largura, altura, num_quadros);
+    if (rgb)
+        fprintf(c, "    .bits_por_pixel = 8,\n    .num_cores = 0,\n    .paleta = 0,\n");
+    else
+        fprintf(c, "    .bits_por_pixel = %u,\n    .num_cores = %zu,\n    .paleta = %s_paleta,\n", bpp, num_cores, nome);
+    fprintf(c, "    .quadros = %s_quadros,\n};\n", nome);
+    fclose(c);
+
+    printf("piskel2pack: %s: %ld quadros %ldx%ld, %zu cores, %zu bytes de quadros (RGB puro: %zu)\n",
+           nome, num_quadros, largura, altura, rgb ? 0 : num_cores, bytes_total, total * 3);
+    return 0;
+}
@@ -0,0 +1,384 @@
+// rtttl2melodia: ferramenta do host que converte uma música RTTTL (o formato
+// dos toques de celular: "nome:d=4,o=5,b=100:8e,8e,p,...") no formato compacto
+// de lib/melodia.h. Roda durante o build (ver add_rtttl_asset no
+// CMakeLists.txt); a melodia fica na flash e é decodificada nota a nota.
+//
+// Uso: rtttl2melodia [-n nome] [-l] -o saida.c -H saida.h entrada.rtttl
+//
+// Com -l a lista de notas (MIDI e duração em ms) também é impressa na saída
+// padrão, para comparar com o que o decodificador da placa produz.
+//
+// Notas: [duração]letra[#][.][oitava][.], com letra em c d e f g a b (ou h) e
+// p para pausa. A oitava segue o RTTTL: a4 = 440 Hz = MIDI 69.
+//
+// Extensão: a duração pode ser dada direto em ticks (1/64 de semibreve) entre
+// colchetes, como em "[18]e", para tempos que não são frações do RTTTL. Com
+// b=375 um tick vale exatamente 10 ms.
+//
+// Várias trilhas: cada linha não vazia do arquivo é uma música RTTTL completa
+// e vira uma trilha (a primeira linha é a trilha 0, a melodia). Com mais de
+// uma trilha a saída começa com o cabeçalho MELODIA_TRILHAS. As trilhas devem
+// ter a mesma duração total; se não tiverem, é emitido um aviso.
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Mesmos códigos de lib/melodia.h
+#define MELODIA_DURACAO 0x80
+#define MELODIA_ANDAMENTO 0xC0
+#define MELODIA_DURACAO_LONGA 0xC1
+#define MELODIA_TRILHAS 0xC2
+#define MELODIA_FIM 0xFF
+#define TRILHAS_MAX 8
+#define TICKS_SEMIBREVE 64
+#define TICKS_INICIAL 16
+
+static uint8_t *saida;
+static size_t saida_bytes, saida_capacidade;
+
+static void erro(const char *msg, const char *detalhe)
+{
+    fprintf(stderr, "rtttl2melodia: %s%s%s\n", msg, detalhe ? ": " : "", detalhe ? detalhe : "");
+    exit(1);
+}
+
+static char *ler_arquivo(const char *caminho)
+{
+    FILE *f = fopen(caminho, "rb");
+    if (!f)
+        erro("não foi possível abrir", caminho);
+
+    fseek(f, 0, SEEK_END);
+    long tamanho = ftell(f);
+    fseek(f, 0, SEEK_SET);
+
+    char *texto = malloc(tamanho + 1);
+    if (!texto || fread(texto, 1, tamanho, f) != (size_t)tamanho)
+        erro("falha ao ler", caminho);
+    texto[tamanho] = '\0';
+    fclose(f);
+    return texto;
+}
+
+static void emitir(uint8_t byte)
+{
+    if (saida_bytes == saida_capacidade)
+    {
+        saida_capacidade = saida_capacidade ? saida_capacidade * 2 : 256;
+        saida = realloc(saida, saida_capacidade);
+        if (!saida)
+            erro("sem memória", NULL);
+    }
+    saida[saida_bytes++] = byte;
+}
+
+static void pular_espacos(const char **p)
+{
+    while (isspace((unsigned char)**p))
+        ++*p;
+}
+
+static long ler_numero(const char **p)
+{
+    long valor = 0;
+    while (isdigit((unsigned char)**p))
+        valor = valor * 10 + (*(*p)++ - '0');
+    return valor;
+}
+
+// Ticks de 1/d de semibreve, com ponto de aumento; 0 se inválido
+static unsigned ticks_duracao(long d, int pontuada)
+{
+    if (d <= 0 || d > TICKS_SEMIBREVE || TICKS_SEMIBREVE % d)
+        return 0;
+    unsigned ticks = TICKS_SEMIBREVE / d;
+    if (pontuada)
+    {
+        if (ticks & 1)
+            return 0;
+        ticks += ticks / 2;
+    }
+    return ticks;
+}
+
+static const char *nome_arquivo(const char *caminho)
+{
+    const char *barra = strrchr(caminho, '/');
+    return barra ? barra + 1 : caminho;
+}
+
+static void escrever_bytes(FILE *f, const uint8_t *dados, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; ++i)
+        fprintf(f, "%s0x%02x,", i % 16 ? " " : "\n    ", dados[i]);
+    fprintf(f, "\n");
+}
+
+// Guarda de inclusão no estilo de lib/: nome em maiúsculas + _H
+static void escrever_guarda(FILE *f, const char *nome, const char *diretiva)
+{
+    fprintf(f, "%s ", diretiva);
+    for (const char *c = nome; *c; ++c)
+        fputc(isalnum((unsigned char)*c) ? toupper((unsigned char)*c) : '_', f);
+    fprintf(f, "_H\n");
+}
+
+// Converte uma linha RTTTL em uma trilha, acrescentada a 'saida'. Retorna a
+// duração total da trilha em ms.
+static unsigned long converter_trilha(const char *linha, const char *entrada, int listar, size_t *num_notas)
+{
+    // Nome (ignorado), padrões e notas, separados por ':'
+    const char *p = strchr(linha, ':');
+    if (!p)
+        erro("faltam as seções do RTTTL", entrada);
+    ++p;
+
+    long duracao_padrao = 4, oitava_padrao = 6, andamento = 63;
+    while (*p && *p != ':')
+    {
+        pular_espacos(&p);
+        char chave = tolower((unsigned char)*p);
+        if (!chave || chave == ':')
+            break;
+        ++p;
+        pular_espacos(&p);
+        if (*p++ != '=')
+            erro("padrão mal formado", entrada);
+        pular_espacos(&p);
+        long valor = ler_numero(&p);
+        if (chave == 'd')
+            duracao_padrao = valor;
+        else if (chave == 'o')
+            oitava_padrao = valor;
+        else if (chave == 'b')
+            andamento = valor;
+        else
+            erro("padrão desconhecido", entrada);
+        pular_espacos(&p);
+        if (*p == ',')
+            ++p;
+    }
+    if (*p++ != ':')
+        erro("faltam as notas", entrada);
+    if (!ticks_duracao(duracao_padrao, 0) || andamento < 1 || andamento > 65535)
+        erro("duração ou andamento padrão inválido", entrada);
+
+    emitir(MELODIA_ANDAMENTO);
+    emitir(andamento & 0xFF);
+    emitir(andamento >> 8);
+
+    static const int semitons[] = {9, 11, 0, 2, 4, 5, 7}; // a b c d e f g
+    unsigned ticks_atual = TICKS_INICIAL;
+    unsigned long ticks_total = 0, fim_ms = 0;
+
+    for (;;)
+    {
+        pular_espacos(&p);
+        if (!*p)
+            break;
+
+        long d = duracao_padrao, ticks_explicitos = 0;
+        if (*p == '[')
+        {
+            ++p;
+            ticks_explicitos = ler_numero(&p);
+            if (*p++ != ']' || ticks_explicitos < 1 || ticks_explicitos > 255)
+                erro("duração em ticks inválida", entrada);
+        }
+        else if (isdigit((unsigned char)*p))
+        {
+            d = ler_numero(&p);
+        }
+        char letra = tolower((unsigned char)*p++);
+        int nota = 0;
+        if (letra == 'p')
+            nota = -1;
+        else if (letra == 'h')
+            nota = 11;
+        else if (letra >= 'a' && letra <= 'g')
+            nota = semitons[letra - 'a'];
+        else
+            erro("nota inválida", entrada);
+
+        if (*p == '#')
+        {
+            ++nota;
+            ++p;
+        }
+        int pontuada = 0;
+        if (*p == '.')
+        {
+            pontuada = 1;
+            ++p;
+        }
+        long oitava = isdigit((unsigned char)*p) ? ler_numero(&p) : oitava_padrao;
+        if (*p == '.')
+        {
+            pontuada = 1;
+            ++p;
+        }
+
+        unsigned ticks = ticks_explicitos ? (pontuada ? 0 : ticks_explicitos) : ticks_duracao(d, pontuada);
+        if (!ticks)
+            erro("duração inválida", entrada);
+
+        int midi = 0;
+        if (letra != 'p')
+        {
+            midi = 12 * (oitava + 1) + nota;
+            if (midi < 1 || midi > 127)
+                erro("nota fora da faixa MIDI", entrada);
+        }
+
+        if (ticks != ticks_atual)
+        {
+            if (ticks <= 64)
+                emitir(MELODIA_DURACAO | (ticks - 1));
+            else
+            {
+                emitir(MELODIA_DURACAO_LONGA);
+                emitir(ticks);
+            }
+            ticks_atual = ticks;
+        }
+        emitir(midi);
+
+        unsigned long inicio = ticks_total * 3750 / andamento;
+        ticks_total += ticks;
+        fim_ms = ticks_total * 3750 / andamento;
+        if (listar)
+            printf("%d %lu\n", midi, fim_ms - inicio);
+        ++*num_notas;
+
+        pular_espacos(&p);
+        if (*p == ',')
+            ++p;
+        else if (*p)
+            erro("esperava ',' entre as notas", entrada);
+    }
+    emitir(MELODIA_FIM);
+    return fim_ms;
+}
+
+static void uso(void)
+{
+    fprintf(stderr, "uso: rtttl2melodia [-n nome] [-l] -o saida.c -H saida.h entrada.rtttl\n");
+    exit(1);
+}
+
+int main(int argc, char **argv)
+{
+    const char *nome = "melodia", *saida_c = NULL, *saida_h = NULL, *entrada = NULL;
+    int listar = 0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (argv[i][0] != '-')
+        {
+            entrada = argv[i];
+            continue;
+        }
+        if (argv[i][1] == 'l')
+        {
+            listar = 1;
+            continue;
+        }
+        if (i + 1 >= argc)
+            uso();
+        const char *valor = argv[++i];
+        switch (argv[i - 1][1])
+        {
+        case 'n':
+            nome = valor;
+            break;
+        case 'o':
+            saida_c = valor;
+            break;
+        case 'H':
+            saida_h = valor;
+            break;
+        default:
+            uso();
+        }
+    }
+    if (!entrada || !saida_c || !saida_h)
+        uso();
+
+    char *texto = ler_arquivo(entrada);
+
+    // Uma trilha por linha não vazia
+    size_t inicio_trilha[TRILHAS_MAX], num_notas = 0;
+    unsigned long duracao_ms[TRILHAS_MAX];
+    int num_trilhas = 0;
+    for (char *linha = strtok(texto, "\r\n"); linha; linha = strtok(NULL, "\r\n"))
+    {
+        const char *p = linha;
+        pular_espacos(&p);
+        if (!*p)
+            continue;
+        if (num_trilhas == TRILHAS_MAX)
+            erro("trilhas demais", entrada);
+        if (listar)
+            printf("# trilha %d\n", num_trilhas);
+        inicio_trilha[num_trilhas] = saida_bytes;
+        duracao_ms[num_trilhas] = converter_trilha(linha, entrada, listar, &num_notas);
+        if (duracao_ms[num_trilhas] != duracao_ms[0])
+            fprintf(stderr, "rtttl2melodia: aviso: trilha %d dura %lu ms, a trilha 0 dura %lu ms\n",
+                    num_trilhas, duracao_ms[num_trilhas], duracao_ms[0]);
+        ++num_trilhas;
+    }
+    if (!num_trilhas)
+        erro("nenhuma trilha", entrada);
+
+    // Cabeçalho: código, número de trilhas e o deslocamento de cada uma a
+    // partir do início do asset
+    size_t cabecalho = num_trilhas > 1 ? 2 + 2 * num_trilhas : 0;
+    if (saida_bytes + cabecalho > 0xFFFF)
+        erro("melodia grande demais para o cabeçalho de trilhas", entrada);
+    uint8_t *trilhas = saida;
+    size_t trilhas_bytes = saida_bytes;
+    saida = NULL;
+    saida_bytes = saida_capacidade = 0;
+    if (cabecalho)
+    {
+        emitir(MELODIA_TRILHAS);
+        emitir(num_trilhas);
+        for (int t = 0; t < num_trilhas; ++t)
+        {
+            size_t deslocamento = cabecalho + inicio_trilha[t];
+            emitir(deslocamento & 0xFF);
+            emitir(deslocamento >> 8);
+        }
+    }
+    for (size_t i = 0; i < trilhas_bytes; ++i)
+        emitir(trilhas[i]);
+
+    FILE *h = fopen(saida_h, "w");
+    if (!h)
+        erro("não foi possível criar", saida_h);
+    fprintf(h, "// Gerado por tools/rtttl2melodia a partir de %s. Não editar.\n", nome_arquivo(entrada));
+    escrever_guarda(h, nome, "#ifndef");
+    escrever_guarda(h, nome, "#define");
+    fprintf(h, "\n#include <stdint.h>\n\n");
+    fprintf(h, "extern const uint8_t %s[];\n", nome);
+    fprintf(h, "\n");
+    escrever_guarda(h, nome, "#endif //");
+    fclose(h);
+
+    FILE *c = fopen(saida_c, "w");
+    if (!c)
+        erro("não foi possível criar", saida_c);
+    fprintf(c, "// Gerado por tools/rtttl2melodia a partir de %s. Não editar.\n", nome_arquivo(entrada));
+    fprintf(c, "#include \"%s\"\n\n", nome_arquivo(saida_h));
+    fprintf(c, "const uint8_t %s[] = {", nome);
+    escrever_bytes(c, saida, saida_bytes);
+    fprintf(c, "};\n");
+    fclose(c);
+
+    fprintf(listar ? stderr : stdout, "rtttl2melodia: %s: %d trilha(s), %zu notas, %zu bytes (note_t: %zu)\n",
+            nome, num_trilhas, num_notas, saida_bytes, num_notas * 4);
+    return 0;
+}